@@ -0,0 +1,39 @@
+# Post-build SRAM report, run with cmake -P
+#
+# Lists the largest statically allocated objects of the ELF so changes to the
+# pattern pool and other fixed buffers show up in every build log.
+#
+# Expects NM, ELF and optionally TOP (number of symbols to list, default 20)
+
+if(NOT DEFINED TOP)
+    set(TOP 20)
+endif()
+
+execute_process(
+    COMMAND ${NM} --print-size --size-sort --reverse-sort -C ${ELF}
+    OUTPUT_VARIABLE symbols
+    RESULT_VARIABLE result
+)
+if(NOT result EQUAL 0)
+    message(WARNING "sram_report: ${NM} failed on ${ELF}")
+    return()
+endif()
+
+string(REPLACE "\n" ";" lines "${symbols}")
+set(total 0)
+set(listed 0)
+set(report "")
+foreach(line IN LISTS lines)
+    # <address> <size> <type> <name>, only zero-initialised (b) and data (d) symbols live in SRAM
+    if(line MATCHES "^[0-9a-f]+ ([0-9a-f]+) ([bBdD]) (.*)$")
+        set(name "${CMAKE_MATCH_3}")
+        math(EXPR size "0x${CMAKE_MATCH_1}")
+        math(EXPR total "${total} + ${size}")
+        if(listed LESS TOP)
+            string(APPEND report "  ${size}\t${name}\n")
+            math(EXPR listed "${listed} + 1")
+        endif()
+    endif()
+endforeach()
+
+message("SRAM: ${total} bytes in static objects, largest:\n${report}")
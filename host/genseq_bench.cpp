@@ -0,0 +1,233 @@
+// Microbenchmarks for the hot path of the sequencer core, results as JSON
+//
+// Reports ns/op and heap allocations/op for the common:: set classes and for a full
+// Sequencer::update() tick with 1, 8 and 64 playing patterns. The sequencer's own diagnostics
+// are discarded so only the JSON reaches stdout.
+//
+// Usage: genseq_bench [--out FILE] [--scale N]
+
+#include "host_shim.h"
+#include "sequencer_host.h"
+#include "common/gate_set.h"
+#include "common/pitch_set.h"
+#include "common/velocity_set.h"
+#include "common/const.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <unistd.h>
+
+// Every heap allocation of the process is counted
+static uint64_t allocationCount = 0;
+
+void* operator new(size_t size) {
+    allocationCount++;
+    if (void* p = malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    free(p);
+}
+
+namespace {
+
+    struct Result {
+        const char* name;
+        uint64_t iterations;
+        double nsPerOp;
+        double allocationsPerOp;
+    };
+
+    // Keeps the compiler from dropping a result that is never read
+    template <typename T>
+    inline void keep(T const& value) {
+        asm volatile("" : : "r,m"(value) : "memory");
+    }
+
+    template <typename Fn>
+    Result measure(const char* name, uint64_t iterations, Fn fn) {
+        // Warm up caches and branch predictors
+        for (uint64_t i = 0; i < iterations / 10 + 1; i++) fn(i);
+
+        uint64_t allocationsBefore = allocationCount;
+        auto start = std::chrono::steady_clock::now();
+        for (uint64_t i = 0; i < iterations; i++) fn(i);
+        auto elapsed = std::chrono::steady_clock::now() - start;
+
+        double ns = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+        return { name, iterations, ns / iterations, static_cast<double>(allocationCount - allocationsBefore) / iterations };
+    }
+
+    // Tick period at the fastest tempo the UI allows
+    constexpr uint16_t BENCH_BPM = 300;
+    constexpr double TICK_BUDGET_NS = 60e9 / (BENCH_BPM * PPQN);
+
+    struct TickResult {
+        Result result;
+        uint8_t patterns;
+        uint32_t txOverflows;
+    };
+
+    // Fill slots up to count with patterns spread over the cycle, then time update() per tick
+    TickResult measureTicks(sequencer::Sequencer& sequencer, uint8_t& patternCount, uint8_t count, uint64_t ticks, const char* name) {
+        commands::sendCommand(commands::Command::STOP);
+        host::runCore1(sequencer);
+
+        for (; patternCount < count; patternCount++) {
+            common::Pattern pattern(
+                common::PitchSet({ 60, 64, 67, 72 }),
+                common::VelocitySet({ 100, 80 }),
+                common::GateSet::createEuclidean(12, 5, patternCount % 12, PPQN * 4),
+                (patternCount % 16) + 1);
+            pattern.setActive(true);
+            commands::sendPattern(patternCount, pattern);
+        }
+        commands::sendCommand(commands::Command::BPM_SET, BENCH_BPM);
+        commands::sendCommand(commands::Command::PLAY);
+        host::runCore1(sequencer);
+
+        uint32_t overflowsBefore = sequencer.getMidiTxStats().overflows;
+        uint64_t allocationsBefore = allocationCount;
+        std::chrono::nanoseconds total{ 0 };
+        uint64_t measured = 0;
+        while (measured < ticks) {
+            // Run UART interrupts until the alarm fires the next tick
+            uint32_t fired = sequencer.getTickStats().ticks;
+            while (sequencer.getTickStats().ticks == fired) {
+                if (!host::runNextEvent(UINT64_MAX)) break;
+            }
+
+            auto start = std::chrono::steady_clock::now();
+            sequencer.update();
+            total += std::chrono::steady_clock::now() - start;
+            measured++;
+        }
+
+        Result result = { name, measured, static_cast<double>(total.count()) / measured,
+            static_cast<double>(allocationCount - allocationsBefore) / measured };
+        return { result, count, sequencer.getMidiTxStats().overflows - overflowsBefore };
+    }
+
+    void printResult(FILE* out, const Result& result, bool last) {
+        fprintf(out, "    {\"name\": \"%s\", \"iterations\": %llu, \"ns_per_op\": %.2f, \"allocations_per_op\": %.4f}%s\n",
+            result.name, static_cast<unsigned long long>(result.iterations), result.nsPerOp,
+            result.allocationsPerOp, last ? "" : ",");
+    }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const char* outPath = nullptr;
+    uint64_t scale = 1;
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--out") && i + 1 < argc) {
+            outPath = argv[++i];
+        }
+        else if (!strcmp(argv[i], "--scale") && i + 1 < argc) {
+            scale = strtoull(argv[++i], nullptr, 10);
+            if (scale == 0) scale = 1;
+        }
+        else {
+            fprintf(stderr, "Usage: %s [--out FILE] [--scale N]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    // JSON goes to the real stdout (or the file), sequencer printf output is discarded
+    FILE* out = outPath ? fopen(outPath, "w") : fdopen(dup(fileno(stdout)), "w");
+    if (!out) {
+        fprintf(stderr, "Cannot write %s\n", outPath ? outPath : "stdout");
+        return 1;
+    }
+    fflush(stdout);
+    if (!freopen("/dev/null", "w", stdout)) return 1;
+
+    host::setUartCaptureEnabled(false);
+
+    Result results[4];
+    uint8_t resultCount = 0;
+
+    {
+        common::GateSet gateSet = common::GateSet::createEuclidean(16, 5, 0, PPQN * 4);
+        uint16_t length = gateSet.getLength();
+        uint16_t position = 0;
+        results[resultCount++] = measure("GateSet::setPosition", 10000000 * scale, [&](uint64_t) {
+            position = position + 1 == length ? 0 : position + 1;
+            gateSet.setPosition(position);
+            keep(gateSet.getFlank());
+        });
+    }
+    results[resultCount++] = measure("GateSet::createEuclidean", 100000 * scale, [](uint64_t i) {
+        common::GateSet gateSet = common::GateSet::createEuclidean(16, 5, i & 0x0F, PPQN * 4);
+        keep(gateSet);
+    });
+    {
+        common::PitchSet pitchSet({ 60, 62, 64, 65, 67, 69, 71, 72 });
+        uint8_t length = pitchSet.getLength();
+        results[resultCount++] = measure("PitchSet::setPosition", 10000000 * scale, [&](uint64_t) {
+            pitchSet.setPosition((pitchSet.getPosition() + 1) % length);
+            keep(pitchSet.getPitch());
+        });
+    }
+    {
+        common::VelocitySet velocitySet({ 100, 80, 100, 90, 110, 70, 90, 100 });
+        uint8_t length = velocitySet.getLength();
+        results[resultCount++] = measure("VelocitySet::setPosition", 10000000 * scale, [&](uint64_t) {
+            velocitySet.setPosition((velocitySet.getPosition() + 1) % length);
+            keep(velocitySet.getVelocity());
+        });
+    }
+
+    // One sequencer for all tick benchmarks, the shim has a single tick alarm owner
+    static sequencer::Sequencer sequencer(uart1, 4, 5);
+    sequencer.init();
+    uint8_t patternCount = 1;   // the sequencer starts with its default pattern in slot 0
+
+    TickResult ticks[3];
+    uint8_t tickCount = 0;
+    ticks[tickCount++] = measureTicks(sequencer, patternCount, 1, 20000 * scale, "Sequencer::update/1");
+    if (MAX_PATTERNS >= 8) ticks[tickCount++] = measureTicks(sequencer, patternCount, 8, 20000 * scale, "Sequencer::update/8");
+    if (MAX_PATTERNS >= 64) ticks[tickCount++] = measureTicks(sequencer, patternCount, 64, 20000 * scale, "Sequencer::update/64");
+
+    fprintf(out, "{\n");
+    fprintf(out, "  \"max_patterns\": %d,\n", MAX_PATTERNS);
+    fprintf(out, "  \"tick_budget_ns\": %.0f,\n", TICK_BUDGET_NS);
+    fprintf(out, "  \"benchmarks\": [\n");
+    for (uint8_t i = 0; i < resultCount; i++) {
+        printResult(out, results[i], false);
+    }
+    for (uint8_t i = 0; i < tickCount; i++) {
+        printResult(out, ticks[i].result, i + 1 == tickCount);
+    }
+    fprintf(out, "  ],\n");
+    fprintf(out, "  \"ticks\": [\n");
+    for (uint8_t i = 0; i < tickCount; i++) {
+        const TickResult& tick = ticks[i];
+        fprintf(out, "    {\"patterns\": %u, \"ns_per_tick\": %.2f, \"budget_used\": %.6f, \"midi_tx_overflows\": %u}%s\n",
+            (unsigned)tick.patterns, tick.result.nsPerOp, tick.result.nsPerOp / TICK_BUDGET_NS,
+            (unsigned)tick.txOverflows, i + 1 == tickCount ? "" : ",");
+    }
+    fprintf(out, "  ],\n");
+
+    // Fixed cost per tick plus the marginal cost per pattern, extrapolated to the tick budget
+    const TickResult& fewest = ticks[0];
+    const TickResult& most = ticks[tickCount - 1];
+    double nsPerPattern = most.patterns > fewest.patterns
+        ? (most.result.nsPerOp - fewest.result.nsPerOp) / (most.patterns - fewest.patterns)
+        : fewest.result.nsPerOp / fewest.patterns;
+    double patternsPerTick = nsPerPattern > 0
+        ? fewest.patterns + (TICK_BUDGET_NS - fewest.result.nsPerOp) / nsPerPattern
+        : 0;
+    fprintf(out, "  \"ns_per_pattern\": %.2f,\n", nsPerPattern);
+    fprintf(out, "  \"patterns_per_tick_budget\": %.0f\n", patternsPerTick);
+    fprintf(out, "}\n");
+    fclose(out);
+    return 0;
+}
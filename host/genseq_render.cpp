@@ -0,0 +1,111 @@
+// Renders the sequencer's MIDI output offline into a Standard MIDI File (format 0)
+//
+// Every byte is timestamped when it finishes leaving the virtual UART, so the file shows
+// exactly what a receiver would get, including serialisation delays.
+//
+// Usage: genseq_render --out FILE [--minutes N] [--bpm N] [--division N]
+
+#include "host_shim.h"
+#include "sequencer_host.h"
+#include "smf_writer.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+
+    struct Options {
+        const char* out = nullptr;
+        double minutes = 1;
+        uint16_t bpm = 120;
+        uint16_t division = 960;
+    };
+
+    bool parseOptions(int argc, char** argv, Options& options) {
+        for (int i = 1; i < argc; i++) {
+            if (!strcmp(argv[i], "--out") && i + 1 < argc) {
+                options.out = argv[++i];
+            }
+            else if (!strcmp(argv[i], "--minutes") && i + 1 < argc) {
+                options.minutes = atof(argv[++i]);
+            }
+            else if (!strcmp(argv[i], "--bpm") && i + 1 < argc) {
+                options.bpm = static_cast<uint16_t>(atoi(argv[++i]));
+            }
+            else if (!strcmp(argv[i], "--division") && i + 1 < argc) {
+                options.division = static_cast<uint16_t>(atoi(argv[++i]));
+            }
+            else {
+                options.out = nullptr;
+                break;
+            }
+        }
+        if (!options.out || options.bpm == 0 || options.division == 0 || options.division > 0x7FFF) {
+            fprintf(stderr, "Usage: %s --out FILE [--minutes N] [--bpm N] [--division N]\n", argv[0]);
+            return false;
+        }
+        return true;
+    }
+
+    struct Recording {
+        host::SmfWriter writer;
+        uint64_t startUs;
+        uint64_t usPerQuarter;
+        uint16_t division;
+    };
+
+    void recordByte(unsigned /*index*/, uint64_t timeUs, uint8_t data, void* context) {
+        Recording& recording = *static_cast<Recording*>(context);
+        // Rounded to the nearest SMF tick of the fixed tempo
+        uint64_t elapsedUs = timeUs - recording.startUs;
+        uint64_t tick = (elapsedUs * recording.division + recording.usPerQuarter / 2) / recording.usPerQuarter;
+        recording.writer.writeByte(static_cast<uint32_t>(tick), data);
+    }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) return 1;
+
+    static Recording recording;
+    recording.startUs = host::now();
+    recording.usPerQuarter = 60000000 / options.bpm;
+    recording.division = options.division;
+    if (!recording.writer.open(options.out, options.division, static_cast<uint32_t>(recording.usPerQuarter), "GenSeq")) {
+        fprintf(stderr, "Cannot write %s\n", options.out);
+        return 1;
+    }
+
+    // Stream bytes to the file instead of keeping them
+    host::setUartCaptureEnabled(false);
+    host::setUartSink(recordByte, &recording);
+
+    static sequencer::Sequencer sequencer(uart1, 4, 5);
+    sequencer.init();
+
+    commands::sendCommand(commands::Command::BPM_SET, options.bpm);
+    commands::sendCommand(commands::Command::PLAY);
+    host::runCore1(sequencer);
+
+    uint64_t endUs = host::now() + static_cast<uint64_t>(options.minutes * 60 * 1000000);
+    while (host::runNextEvent(endUs)) {
+        host::runCore1(sequencer);
+    }
+
+    commands::sendCommand(commands::Command::STOP);
+    host::runCore1(sequencer);
+    // Let the note offs leave the UART
+    while (host::runNextEvent(UINT64_MAX)) {
+        host::runCore1(sequencer);
+    }
+
+    host::setUartSink(nullptr, nullptr);
+    uint32_t events = recording.writer.getEventCount();
+    if (!recording.writer.close()) {
+        fprintf(stderr, "Writing %s failed\n", options.out);
+        return 1;
+    }
+    printf("Wrote %u events to %s\n", (unsigned)events, options.out);
+    return 0;
+}
@@ -0,0 +1,101 @@
+// Runs the sequencer core against the virtual clock of the HAL shim, faster than real time
+//
+// Usage: genseq_sim [--minutes N] [--bpm N]
+
+#include "host_shim.h"
+#include "sequencer_host.h"
+#include "common/profiler.h"
+#include "sequencer/sequencer.h"
+#include "commands/command.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+
+    struct Options {
+        double minutes = 60;
+        uint16_t bpm = 120;
+    };
+
+    bool parseOptions(int argc, char** argv, Options& options) {
+        for (int i = 1; i < argc; i++) {
+            if (!strcmp(argv[i], "--minutes") && i + 1 < argc) {
+                options.minutes = atof(argv[++i]);
+            }
+            else if (!strcmp(argv[i], "--bpm") && i + 1 < argc) {
+                options.bpm = static_cast<uint16_t>(atoi(argv[++i]));
+            }
+            else {
+                fprintf(stderr, "Usage: %s [--minutes N] [--bpm N]\n", argv[0]);
+                return false;
+            }
+        }
+        return true;
+    }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) return 1;
+
+    host::setUartCaptureEnabled(false);
+
+    static sequencer::Sequencer sequencer(uart1, 4, 5);
+    sequencer.init();
+
+    commands::sendCommand(commands::Command::BPM_SET, options.bpm);
+    commands::sendCommand(commands::Command::PLAY);
+    host::runCore1(sequencer);
+
+    uint64_t endUs = host::now() + static_cast<uint64_t>(options.minutes * 60 * 1000000);
+    uint64_t updates = 0;
+    uint64_t tickedUpdates = 0;
+    std::chrono::nanoseconds tickTime{ 0 };
+    std::chrono::nanoseconds tickTimeMax{ 0 };
+
+    auto wallStart = std::chrono::steady_clock::now();
+    uint32_t processedTicks = sequencer.getTickStats().ticks;
+    while (host::runNextEvent(endUs)) {
+        // Ticks are fired by the alarm callback, update() processes them
+        uint32_t firedTicks = sequencer.getTickStats().ticks;
+
+        auto start = std::chrono::steady_clock::now();
+        host::runCore1(sequencer);
+        auto elapsed = std::chrono::steady_clock::now() - start;
+
+        updates++;
+        if (firedTicks != processedTicks) {
+            processedTicks = firedTicks;
+            tickedUpdates++;
+            tickTime += elapsed;
+            if (elapsed > tickTimeMax) tickTimeMax = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed);
+        }
+    }
+    double wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+
+    sequencer::TickStats tickStats = sequencer.getTickStats();
+    sequencer::MidiTxStats txStats = sequencer.getMidiTxStats();
+
+    commands::sendCommand(commands::Command::STOP);
+    host::runCore1(sequencer);
+    // Let the note offs leave the UART
+    host::advanceTo(host::now() + 1000000);
+
+    double simSeconds = options.minutes * 60;
+    printf("Simulated %.0fs at %u BPM in %.3fs (%.0fx real time)\n",
+        simSeconds, (unsigned)options.bpm, wallSeconds, wallSeconds > 0 ? simSeconds / wallSeconds : 0);
+    printf("Ticks: %u missed=%u overruns=%u\n",
+        (unsigned)tickStats.ticks, (unsigned)tickStats.missed, (unsigned)tickStats.overruns);
+    printf("Tick cost: avg=%.0fns max=%lldns over %llu ticked updates (%llu updates)\n",
+        tickedUpdates ? static_cast<double>(tickTime.count()) / tickedUpdates : 0.0,
+        static_cast<long long>(tickTimeMax.count()),
+        static_cast<unsigned long long>(tickedUpdates), static_cast<unsigned long long>(updates));
+    printf("MIDI bytes sent: %llu, TX queue highWater=%u overflows=%u\n",
+        static_cast<unsigned long long>(host::uartByteCount(1)),
+        (unsigned)txStats.highWater, (unsigned)txStats.overflows);
+    common::dumpProfileZones();
+    return 0;
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include "sequencer/sequencer.h"
+#include "commands/command.h"
+#include "common/log.h"
+
+namespace host {
+
+    // One pass of the sequencer task on core 1: commands first, then the due ticks.
+    // The host has no UI loop, so the pass also prints the deferred log.
+    inline void runCore1(sequencer::Sequencer& sequencer) {
+        commands::receiveCommands([](const commands::CommandMessage& msg, void* context) {
+            static_cast<sequencer::Sequencer*>(context)->processCommand(msg);
+        }, &sequencer);
+        sequencer.update();
+        common::drainLog(UINT16_MAX);
+    }
+
+} // namespace host
@@ -0,0 +1,275 @@
+#include "host_shim.h"
+#include "pico/multicore.h"
+#include "hardware/timer.h"
+#include "hardware/irq.h"
+#include "hardware/uart.h"
+#include <cstdio>
+
+struct uart_inst {
+    uint index;
+};
+
+namespace host {
+
+    static constexpr uint ALARM_COUNT = 4;
+    static constexpr uint IRQ_COUNT = 32;
+    static constexpr size_t FIFO_DEPTH = 8;
+    static constexpr size_t UART_FIFO_DEPTH = 32;
+    // Default TX interrupt level, asserted while the FIFO is at most half full
+    static constexpr size_t UART_TX_IRQ_LEVEL = UART_FIFO_DEPTH / 2;
+
+    struct Alarm {
+        bool claimed;
+        bool armed;
+        uint64_t targetUs;
+        hardware_alarm_callback_t callback;
+    };
+
+    struct QueuedByte {
+        uint64_t doneUs;
+        uint8_t data;
+    };
+
+    // Fixed capacity queue, so the shim itself never allocates while the sequencer runs
+    template <typename T, size_t N>
+    struct FixedQueue {
+        T items[N];
+        size_t head;
+        size_t count;
+
+        bool empty() const { return count == 0; }
+        size_t size() const { return count; }
+        const T& front() const { return items[head]; }
+        void push_back(const T& item) { items[(head + count++) % N] = item; }
+        void pop_front() { head = (head + 1) % N; count--; }
+        void clear() { head = 0; count = 0; }
+    };
+
+    struct Uart {
+        uint32_t bytePeriodUs;
+        uint64_t lineFreeUs;
+        bool txIrqEnabled;
+        FixedQueue<QueuedByte, UART_FIFO_DEPTH> txFifo;
+        std::vector<UartByte> capture;
+        uint64_t byteCount;
+    };
+
+    static uint64_t clockUs = 0;
+    static Alarm alarms[ALARM_COUNT] = {};
+    static irq_handler_t irqHandlers[IRQ_COUNT] = {};
+    static bool irqEnabled[IRQ_COUNT] = {};
+    static Uart uarts[2] = {};
+    static bool captureEnabled = true;
+    static UartSink uartSink = nullptr;
+    static void* uartSinkContext = nullptr;
+    static FixedQueue<uint32_t, FIFO_DEPTH> fifo;
+
+    uint64_t now() {
+        return clockUs;
+    }
+
+    uint64_t nextEventUs() {
+        uint64_t next = UINT64_MAX;
+        for (const Alarm& alarm : alarms) {
+            if (alarm.armed && alarm.targetUs < next) next = alarm.targetUs;
+        }
+        for (const Uart& uart : uarts) {
+            if (!uart.txFifo.empty() && uart.txFifo.front().doneUs < next) next = uart.txFifo.front().doneUs;
+        }
+        return next;
+    }
+
+    static void runUartTx(uint index) {
+        Uart& uart = uarts[index];
+        QueuedByte byte = uart.txFifo.front();
+        uart.txFifo.pop_front();
+        uart.byteCount++;
+        if (captureEnabled) uart.capture.push_back({ byte.doneUs, byte.data });
+        if (uartSink) uartSink(index, byte.doneUs, byte.data, uartSinkContext);
+
+        uint irq = UART0_IRQ + index;
+        if (uart.txIrqEnabled && uart.txFifo.size() <= UART_TX_IRQ_LEVEL && irqEnabled[irq] && irqHandlers[irq]) {
+            irqHandlers[irq]();
+        }
+    }
+
+    bool runNextEvent(uint64_t limitUs) {
+        uint64_t next = nextEventUs();
+        if (next == UINT64_MAX || next > limitUs) {
+            if (limitUs != UINT64_MAX && limitUs > clockUs) clockUs = limitUs;
+            return false;
+        }
+        if (next > clockUs) clockUs = next;
+
+        // Alarms first, a tick due at the same time as a byte must not wait for it
+        for (uint num = 0; num < ALARM_COUNT; num++) {
+            Alarm& alarm = alarms[num];
+            if (alarm.armed && alarm.targetUs <= clockUs) {
+                alarm.armed = false;
+                if (alarm.callback) alarm.callback(num);
+                return true;
+            }
+        }
+        for (uint index = 0; index < 2; index++) {
+            if (!uarts[index].txFifo.empty() && uarts[index].txFifo.front().doneUs <= clockUs) {
+                runUartTx(index);
+                return true;
+            }
+        }
+        return true;
+    }
+
+    void advanceTo(uint64_t timeUs) {
+        while (runNextEvent(timeUs)) {
+        }
+    }
+
+    std::vector<UartByte>& uartCapture(unsigned index) {
+        return uarts[index & 1].capture;
+    }
+
+    void setUartSink(UartSink sink, void* context) {
+        uartSink = sink;
+        uartSinkContext = context;
+    }
+
+    void setUartCaptureEnabled(bool enabled) {
+        captureEnabled = enabled;
+    }
+
+    uint64_t uartByteCount(unsigned index) {
+        return uarts[index & 1].byteCount;
+    }
+
+} // namespace host
+
+using namespace host;
+
+// Timer
+
+uint64_t time_us_64(void) {
+    return clockUs;
+}
+
+int hardware_alarm_claim_unused(bool required) {
+    for (uint num = 0; num < ALARM_COUNT; num++) {
+        if (!alarms[num].claimed) {
+            alarms[num].claimed = true;
+            return num;
+        }
+    }
+    if (required) {
+        fprintf(stderr, "hardware_alarm_claim_unused: no alarm left\n");
+    }
+    return -1;
+}
+
+void hardware_alarm_unclaim(uint alarm_num) {
+    alarms[alarm_num].claimed = false;
+    alarms[alarm_num].armed = false;
+}
+
+void hardware_alarm_set_callback(uint alarm_num, hardware_alarm_callback_t callback) {
+    alarms[alarm_num].callback = callback;
+}
+
+bool hardware_alarm_set_target(uint alarm_num, absolute_time_t t) {
+    uint64_t targetUs = to_us_since_boot(t);
+    if (targetUs <= clockUs) return true;
+    alarms[alarm_num].targetUs = targetUs;
+    alarms[alarm_num].armed = true;
+    return false;
+}
+
+void hardware_alarm_cancel(uint alarm_num) {
+    alarms[alarm_num].armed = false;
+}
+
+// Interrupts
+
+void irq_set_exclusive_handler(uint num, irq_handler_t handler) {
+    if (num < IRQ_COUNT) irqHandlers[num] = handler;
+}
+
+void irq_set_enabled(uint num, bool enabled) {
+    if (num < IRQ_COUNT) irqEnabled[num] = enabled;
+}
+
+// UART
+
+static uart_inst uartInstances[2] = { { 0 }, { 1 } };
+uart_inst_t* const host_uarts[2] = { &uartInstances[0], &uartInstances[1] };
+
+uint uart_init(uart_inst_t* uart, uint baudrate) {
+    Uart& state = uarts[uart->index];
+    // Start bit, 8 data bits, stop bit
+    state.bytePeriodUs = baudrate > 0 ? (10 * 1000000 + baudrate - 1) / baudrate : 0;
+    state.lineFreeUs = clockUs;
+    return baudrate;
+}
+
+uint uart_get_index(uart_inst_t* uart) {
+    return uart->index;
+}
+
+bool uart_is_writable(uart_inst_t* uart) {
+    return uarts[uart->index].txFifo.size() < UART_FIFO_DEPTH;
+}
+
+void uart_putc_raw(uart_inst_t* uart, char c) {
+    Uart& state = uarts[uart->index];
+    if (state.txFifo.size() >= UART_FIFO_DEPTH) return;
+
+    // Bytes go out back to back, an idle line starts right away
+    uint64_t startUs = state.lineFreeUs > clockUs ? state.lineFreeUs : clockUs;
+    state.lineFreeUs = startUs + state.bytePeriodUs;
+    state.txFifo.push_back({ state.lineFreeUs, static_cast<uint8_t>(c) });
+}
+
+void uart_set_irq_enables(uart_inst_t* uart, bool rx_has_data, bool tx_needs_data) {
+    (void)rx_has_data;
+    // Only raised when a byte completes, see runUartTx
+    uarts[uart->index].txIrqEnabled = tx_needs_data;
+}
+
+// Multicore
+
+void multicore_launch_core1(void (*entry)(void)) {
+    // Never started, the host loop calls into the sequencer itself
+    (void)entry;
+}
+
+bool multicore_fifo_rvalid(void) {
+    return !fifo.empty();
+}
+
+bool multicore_fifo_wready(void) {
+    return fifo.size() < FIFO_DEPTH;
+}
+
+void multicore_fifo_push_blocking(uint32_t data) {
+    // Both cores share one thread, a full FIFO would never drain
+    if (fifo.size() >= FIFO_DEPTH) {
+        fprintf(stderr, "multicore_fifo_push_blocking: FIFO full, word dropped\n");
+        return;
+    }
+    fifo.push_back(data);
+}
+
+bool multicore_fifo_push_timeout_us(uint32_t data, uint64_t timeout_us) {
+    (void)timeout_us;
+    if (fifo.size() >= FIFO_DEPTH) return false;
+    fifo.push_back(data);
+    return true;
+}
+
+uint32_t multicore_fifo_pop_blocking(void) {
+    if (fifo.empty()) return 0;
+    uint32_t data = fifo.front();
+    fifo.pop_front();
+    return data;
+}
+
+void multicore_fifo_drain(void) {
+    fifo.clear();
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+// Host side controls of the Pico SDK stand-in.
+//
+// Nothing runs on its own: the virtual clock only moves when the host loop advances it, and
+// alarm callbacks and UART interrupts are run from there, in time order, like an ISR that
+// preempts the main loop between two statements.
+namespace host {
+
+    // A byte that finished leaving a UART
+    struct UartByte {
+        uint64_t timeUs;
+        uint8_t data;
+    };
+
+    uint64_t now();
+
+    // Time of the next alarm or UART byte, UINT64_MAX if nothing is pending
+    uint64_t nextEventUs();
+
+    /**
+     * @brief Jump to the next pending event and run its interrupt
+     *
+     * @return false if nothing is due before limitUs, the clock then stops at limitUs
+     *         (or stays put if nothing is pending and limitUs is UINT64_MAX)
+     */
+    bool runNextEvent(uint64_t limitUs);
+
+    // Run every event due up to timeUs, then move the clock there
+    void advanceTo(uint64_t timeUs);
+
+    // Called for every byte that finished leaving a UART, in time order
+    using UartSink = void (*)(unsigned index, uint64_t timeUs, uint8_t data, void* context);
+    void setUartSink(UartSink sink, void* context);
+
+    // Bytes transmitted on a UART so far
+    std::vector<UartByte>& uartCapture(unsigned index);
+
+    // Capturing hours of playback adds up, the byte count is kept either way
+    void setUartCaptureEnabled(bool enabled);
+    uint64_t uartByteCount(unsigned index);
+
+} // namespace host
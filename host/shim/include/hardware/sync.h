@@ -0,0 +1,20 @@
+#pragma once
+
+#include "pico/types.h"
+
+// Interrupts only run from the host loop, never in the middle of sequencer code,
+// so masking them and ordering memory reduce to compiler barriers
+
+static inline uint32_t save_and_disable_interrupts(void) {
+    __asm__ volatile("" ::: "memory");
+    return 0;
+}
+
+static inline void restore_interrupts(uint32_t status) {
+    (void)status;
+    __asm__ volatile("" ::: "memory");
+}
+
+static inline void __dmb(void) { __asm__ volatile("" ::: "memory"); }
+static inline void __sev(void) {}
+static inline void __wfe(void) {}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "pico/types.h"
+
+typedef struct uart_inst uart_inst_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern uart_inst_t* const host_uarts[2];
+#define uart0 (host_uarts[0])
+#define uart1 (host_uarts[1])
+
+// Bytes leave the TX FIFO at the configured baud rate of the virtual clock and are captured
+uint uart_init(uart_inst_t* uart, uint baudrate);
+uint uart_get_index(uart_inst_t* uart);
+bool uart_is_writable(uart_inst_t* uart);
+void uart_putc_raw(uart_inst_t* uart, char c);
+void uart_set_irq_enables(uart_inst_t* uart, bool rx_has_data, bool tx_needs_data);
+
+#ifdef __cplusplus
+}
+#endif
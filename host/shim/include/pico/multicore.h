@@ -0,0 +1,23 @@
+#pragma once
+
+#include "pico/types.h"
+#include "pico/time.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// The simulation runs both cores on one thread, core 1 is driven by the host loop
+void multicore_launch_core1(void (*entry)(void));
+
+// Inter-core FIFO stand-in, 8 entries deep like the hardware
+bool multicore_fifo_rvalid(void);
+bool multicore_fifo_wready(void);
+void multicore_fifo_push_blocking(uint32_t data);
+bool multicore_fifo_push_timeout_us(uint32_t data, uint64_t timeout_us);
+uint32_t multicore_fifo_pop_blocking(void);
+void multicore_fifo_drain(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,10 @@
+#pragma once
+
+#include <stdio.h>
+#include "pico/types.h"
+#include "pico/time.h"
+#include "hardware/gpio.h"
+#include "hardware/uart.h"
+
+static inline bool stdio_init_all(void) { return true; }
+static inline void tight_loop_contents(void) {}
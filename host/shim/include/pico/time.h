@@ -0,0 +1,6 @@
+#pragma once
+
+#include "pico/types.h"
+#include "hardware/timer.h"
+
+static inline absolute_time_t get_absolute_time(void) { return from_us_since_boot(time_us_64()); }
@@ -0,0 +1,229 @@
+#include "smf_writer.h"
+#include <cstring>
+
+namespace host {
+
+    // Data bytes following a status byte, 0xFF for status bytes that never take data
+    static uint8_t dataLength(uint8_t status) {
+        switch (status & 0xF0) {
+        case 0xC0:
+        case 0xD0:
+            return 1;
+        case 0xF0:
+            break;
+        default:
+            return 2;
+        }
+        switch (status) {
+        case 0xF1:
+        case 0xF3:
+            return 1;
+        case 0xF2:
+            return 2;
+        default:
+            return 0;
+        }
+    }
+
+    SmfWriter::SmfWriter() :
+        file(nullptr),
+        failed(false),
+        trackLengthOffset(0),
+        lastTick(0),
+        eventCount(0),
+        runningStatus(0),
+        message{},
+        messageLength(0),
+        expectedLength(0),
+        messageTick(0),
+        inSysex(false),
+        sysexStarted(false),
+        sysex{},
+        sysexLength(0),
+        sysexTick(0) {
+    }
+
+    SmfWriter::~SmfWriter() {
+        close();
+    }
+
+    bool SmfWriter::open(const char* path, uint16_t division, uint32_t usPerQuarter, const char* trackName) {
+        close();
+        file = fopen(path, "wb");
+        if (!file) return false;
+
+        failed = false;
+        lastTick = 0;
+        eventCount = 0;
+        runningStatus = 0;
+        messageLength = 0;
+        expectedLength = 0;
+        inSysex = false;
+
+        writeRaw("MThd", 4);
+        writeBigEndian(6, 4);
+        writeBigEndian(0, 2);   // format 0
+        writeBigEndian(1, 2);   // one track
+        writeBigEndian(division, 2);
+
+        writeRaw("MTrk", 4);
+        trackLengthOffset = ftell(file);
+        writeBigEndian(0, 4);   // patched by close()
+
+        uint8_t tempo[3] = {
+            static_cast<uint8_t>(usPerQuarter >> 16),
+            static_cast<uint8_t>(usPerQuarter >> 8),
+            static_cast<uint8_t>(usPerQuarter),
+        };
+        writeMeta(0, 0x51, tempo, sizeof(tempo));
+        if (trackName) {
+            writeMeta(0, 0x03, reinterpret_cast<const uint8_t*>(trackName), static_cast<uint32_t>(strlen(trackName)));
+        }
+        return !failed;
+    }
+
+    void SmfWriter::writeByte(uint32_t tick, uint8_t byte) {
+        if (!file) return;
+
+        if (byte >= 0xF8) {
+            // Real-time bytes may appear anywhere, even inside another message
+            writeEvent(tick, 0xF7, &byte, 1, true);
+            return;
+        }
+
+        if (inSysex) {
+            if (byte == 0xF7) {
+                flushSysex(true);
+                return;
+            }
+            if (byte < 0x80) {
+                if (sysexLength == SYSEX_CHUNK) flushSysex(false);
+                sysex[sysexLength++] = byte;
+                return;
+            }
+            // Any other status ends an unterminated SysEx
+            flushSysex(true);
+        }
+
+        if (byte == 0xF0) {
+            runningStatus = 0;
+            inSysex = true;
+            sysexStarted = false;
+            sysexLength = 0;
+            sysexTick = tick;
+            return;
+        }
+
+        if (byte >= 0x80) {
+            startMessage(tick, byte);
+        }
+        else if (messageLength == 0) {
+            // Data byte without status: running status, or garbage if none is set
+            if (runningStatus == 0) return;
+            startMessage(tick, runningStatus);
+            message[messageLength++] = byte;
+        }
+        else {
+            message[messageLength++] = byte;
+        }
+
+        if (messageLength > 0 && messageLength == expectedLength + 1) {
+            if (message[0] >= 0xF0) {
+                writeEvent(messageTick, 0xF7, message, messageLength, true);
+            }
+            else {
+                writeEvent(messageTick, message[0], message + 1, messageLength - 1, false);
+            }
+            messageLength = 0;
+        }
+    }
+
+    void SmfWriter::startMessage(uint32_t tick, uint8_t status) {
+        // Channel messages set running status, system common messages cancel it
+        runningStatus = status < 0xF0 ? status : 0;
+        message[0] = status;
+        messageLength = 1;
+        expectedLength = dataLength(status);
+        messageTick = tick;
+    }
+
+    void SmfWriter::flushSysex(bool end) {
+        if (end) {
+            if (sysexLength == SYSEX_CHUNK) flushSysex(false);
+            sysex[sysexLength++] = 0xF7;
+        }
+        // The first packet starts with F0, the rest are continuation escapes
+        writeEvent(sysexTick, sysexStarted ? 0xF7 : 0xF0, sysex, sysexLength, true);
+        sysexStarted = true;
+        sysexLength = 0;
+        if (end) inSysex = false;
+    }
+
+    bool SmfWriter::close() {
+        if (!file) return true;
+
+        if (inSysex) flushSysex(true);
+
+        writeMeta(lastTick, 0x2F, nullptr, 0);  // end of track
+
+        long end = ftell(file);
+        if (end < 0 || fseek(file, trackLengthOffset, SEEK_SET) != 0) failed = true;
+        writeBigEndian(static_cast<uint32_t>(end - trackLengthOffset - 4), 4);
+        if (fclose(file) != 0) failed = true;
+        file = nullptr;
+        return !failed;
+    }
+
+    void SmfWriter::writeEvent(uint32_t tick, uint8_t prefix, const uint8_t* data, uint32_t length, bool withLength) {
+        // Bytes reach the writer in time order, never go back
+        if (tick < lastTick) tick = lastTick;
+        writeVarLen(tick - lastTick);
+        lastTick = tick;
+
+        writeRaw(&prefix, 1);
+        if (withLength) writeVarLen(length);
+        writeRaw(data, length);
+        eventCount++;
+    }
+
+    void SmfWriter::writeMeta(uint32_t tick, uint8_t type, const uint8_t* data, uint32_t length) {
+        if (tick < lastTick) tick = lastTick;
+        writeVarLen(tick - lastTick);
+        lastTick = tick;
+
+        uint8_t prefix[2] = { 0xFF, type };
+        writeRaw(prefix, sizeof(prefix));
+        writeVarLen(length);
+        writeRaw(data, length);
+    }
+
+    void SmfWriter::writeVarLen(uint32_t value) {
+        uint8_t bytes[5];
+        uint8_t count = 0;
+        bytes[count++] = value & 0x7F;
+        while (value >>= 7) {
+            bytes[count++] = 0x80 | (value & 0x7F);
+        }
+        // Most significant group first
+        for (uint8_t i = 0; i < count / 2; i++) {
+            uint8_t swap = bytes[i];
+            bytes[i] = bytes[count - 1 - i];
+            bytes[count - 1 - i] = swap;
+        }
+        writeRaw(bytes, count);
+    }
+
+    void SmfWriter::writeRaw(const void* data, uint32_t length) {
+        if (length == 0) return;
+        if (fwrite(data, 1, length, file) != length) failed = true;
+    }
+
+    void SmfWriter::writeBigEndian(uint32_t value, uint8_t bytes) {
+        uint8_t buffer[4];
+        for (uint8_t i = 0; i < bytes; i++) {
+            buffer[i] = static_cast<uint8_t>(value >> (8 * (bytes - 1 - i)));
+        }
+        writeRaw(buffer, bytes);
+    }
+
+} // namespace host
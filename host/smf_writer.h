@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+
+namespace host {
+
+    // Streaming writer for Standard MIDI Files, format 0.
+    //
+    // Takes the raw byte stream of a MIDI output together with a timestamp per byte, assembles it
+    // into events (expanding running status) and appends each event to the file right away. Only
+    // the track length is patched when the file is closed, so memory use does not grow with the
+    // length of the recording. System real-time and common messages are kept as escape events.
+    class SmfWriter {
+    public:
+        SmfWriter();
+        ~SmfWriter();
+
+        /**
+         * @brief Create the file and write the header, tempo and track name
+         *
+         * @param division SMF ticks per quarter note
+         * @param usPerQuarter Tempo written at tick 0, also the basis for converting wire times
+         */
+        bool open(const char* path, uint16_t division, uint32_t usPerQuarter, const char* trackName);
+
+        // Feed one byte of the MIDI stream, sent at the given SMF tick
+        void writeByte(uint32_t tick, uint8_t byte);
+
+        // End the track and patch its length, returns false if any write failed
+        bool close();
+
+        uint32_t getEventCount() const { return eventCount; }
+
+    private:
+        static constexpr uint16_t SYSEX_CHUNK = 128;
+
+        FILE* file;
+        bool failed;
+        long trackLengthOffset;
+        uint32_t lastTick;
+        uint32_t eventCount;
+
+        // Channel or system common message being assembled
+        uint8_t runningStatus;
+        uint8_t message[3];
+        uint8_t messageLength;
+        uint8_t expectedLength;
+        uint32_t messageTick;
+
+        // SysEx is written in chunks, continued with escape events
+        bool inSysex;
+        bool sysexStarted;
+        uint8_t sysex[SYSEX_CHUNK];
+        uint16_t sysexLength;
+        uint32_t sysexTick;
+
+        void startMessage(uint32_t tick, uint8_t status);
+        void flushSysex(bool end);
+        void writeEvent(uint32_t tick, uint8_t prefix, const uint8_t* data, uint32_t length, bool withLength);
+        void writeMeta(uint32_t tick, uint8_t type, const uint8_t* data, uint32_t length);
+        void writeVarLen(uint32_t value);
+        void writeRaw(const void* data, uint32_t length);
+        void writeBigEndian(uint32_t value, uint8_t bytes);
+    };
+
+} // namespace host
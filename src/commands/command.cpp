@@ -1,32 +1,66 @@
-#include <stdio.h>
 #include "command.h"
+#include "command_ring.h"
+#include "../common/log.h"
 #include "pico/multicore.h"
 
 namespace commands {
 
-    // Function to send a command to the sequencer core
-    void sendCommand(Command cmd, uint8_t param1, uint8_t param2) {
-        // Pack command and parameters into a single 32-bit value
-        uint32_t packed = static_cast<uint32_t>(cmd) |
-            (param1 << 8) |
-            (param2 << 16);
-        
-            printf("Sending command: %d, param1: %d, param2: %d\n", cmd, param1, param2);
-
-        // Send to the sequencer core
-        multicore_fifo_push_blocking(packed);
+    // Commands from the UI core to the sequencer core
+    static CommandRing commandRing;
+    static uint16_t expectedSequence = 0;
+
+    // Any value will do, the FIFO only signals that the ring has new records
+    static constexpr uint32_t DOORBELL = 1;
+
+    static void ringDoorbell() {
+        // A full FIFO already has doorbells pending, so skipping one loses nothing
+        if (multicore_fifo_wready()) {
+            multicore_fifo_push_blocking(DOORBELL);
+        }
+    }
+
+    bool sendCommand(Command cmd, uint16_t param1, uint16_t param2) {
+        LOG_DEBUG("Sending command: %d, param1: %d, param2: %d\n", cmd, param1, param2);
+
+        if (!commandRing.push(static_cast<uint8_t>(cmd), param1, param2, nullptr, 0)) return false;
+
+        ringDoorbell();
+        return true;
     }
 
-    CommandMessage receiveCommand() {
-        commands::CommandMessage msg = {commands::Command::NOOP, 0, 0};
-        if (multicore_fifo_rvalid()) {
-            uint32_t raw_cmd = multicore_fifo_pop_blocking();
-            msg.cmd = static_cast<commands::Command>(raw_cmd & 0xFF);
-            msg.param1 = (raw_cmd >> 8) & 0xFFFF;
-            msg.param2 = (raw_cmd >> 16) & 0xFF;
-            printf("Receiving command: %d, param1: %d, param2: %d\n", msg.cmd, msg.param1, msg.param2);
+    bool sendCommand(Command cmd, uint16_t param1, const uint8_t* payload, uint8_t length) {
+        LOG_DEBUG("Sending command: %d, param1: %d, payload: %d bytes\n", cmd, param1, length);
+
+        if (!commandRing.push(static_cast<uint8_t>(cmd), param1, 0, payload, length)) return false;
+
+        ringDoorbell();
+        return true;
+    }
+
+    uint16_t receiveCommands(CommandHandler handler, void* context) {
+        // Doorbells carry no data, the ring is drained either way
+        while (multicore_fifo_rvalid()) {
+            multicore_fifo_pop_blocking();
         }
-        return msg;
+        if (commandRing.isEmpty()) return 0;
+
+        return commandRing.drain([handler, context](const CommandHeader& header, const uint8_t* payload) {
+            CommandMessage msg = {
+                static_cast<Command>(header.cmd),
+                header.sequence,
+                header.param1,
+                header.param2,
+                payload,
+                header.length,
+            };
+            if (msg.sequence != expectedSequence) {
+                LOG_WARN("Commands dropped: %d\n", (uint16_t)(msg.sequence - expectedSequence));
+            }
+            expectedSequence = msg.sequence + 1;
+
+            LOG_DEBUG("Receiving command: %d, param1: %d, param2: %d\n", msg.cmd, msg.param1, msg.param2);
+            handler(msg, context);
+        });
     }
 
 } // namespace commands
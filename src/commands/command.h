@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include "pico/multicore.h"
 
 namespace commands {
@@ -16,24 +17,44 @@ namespace commands {
         PATTERN_EUCLIDEAN_SET_PULSES,
         PATTERN_EUCLIDEAN_SET_ROTATION,
         PATTERN_EUCLIDEAN_SET_LENGTH,
+        MIDI_RUNNING_STATUS_SET,
+        PATTERN_PITCHES_SET,        // param1: pattern, payload: pitches
+        PATTERN_VELOCITIES_SET,     // param1: pattern, payload: velocities
         // Add more commands as needed
     };
 
     // Command message structure for inter-core communication
     struct CommandMessage {
         Command cmd;
-        uint8_t param1;
-        uint8_t param2;
+        uint16_t sequence;
+        uint16_t param1;
+        uint16_t param2;
+        const uint8_t* payload;     // only valid while the message is handled
+        uint8_t payloadLength;
     };
 
-    // Function to send a command to the sequencer core
-    void sendCommand(Command cmd, uint8_t param1 = 0, uint8_t param2 = 0);
+    /**
+     * @brief Send a command to the sequencer core
+     *
+     * Queued in a ring in shared SRAM, never blocks the UI core.
+     *
+     * @return false if the ring is full and the command was dropped
+     */
+    bool sendCommand(Command cmd, uint16_t param1 = 0, uint16_t param2 = 0);
+
+    // Send a command with a variable-length payload (at most 255 bytes)
+    bool sendCommand(Command cmd, uint16_t param1, const uint8_t* payload, uint8_t length);
+
+    // Called for every received command, context is passed through from receiveCommands
+    using CommandHandler = void (*)(const CommandMessage& msg, void* context);
 
     /**
-     * @brief Receive a command message from the UI core
-     * 
-     * @return CommandMessage with the received command and parameters
+     * @brief Handle all commands queued by the UI core
+     *
+     * Called on the sequencer core. Drains the whole ring in one batch.
+     *
+     * @return Number of commands handled
      */
-    CommandMessage receiveCommand();
+    uint16_t receiveCommands(CommandHandler handler, void* context = nullptr);
 
 } // namespace commands
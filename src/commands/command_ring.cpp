@@ -0,0 +1,58 @@
+#include "command_ring.h"
+
+namespace commands {
+
+    CommandRing::CommandRing() :
+        head(0),
+        tail(0),
+        sequence(0),
+        highWater(0),
+        dropped(0) {
+    }
+
+    bool CommandRing::push(uint8_t cmd, uint16_t param1, uint16_t param2, const uint8_t* payload, uint8_t length) {
+        // Consumed a sequence number either way, so the consumer can spot the drop
+        uint16_t recordSequence = sequence++;
+
+        uint32_t size = recordSize(length);
+        uint32_t position = head;
+        uint32_t toEnd = CAPACITY - (position & MASK);
+        // A record that does not fit before the end starts over at the beginning
+        uint32_t skip = toEnd < size ? toEnd : 0;
+
+        uint32_t used = position - tail;
+        if (used + skip + size > CAPACITY) {
+            dropped++;
+            return false;
+        }
+
+        if (skip) {
+            reinterpret_cast<CommandHeader*>(&buffer[position & MASK])->cmd = PAD;
+            position += skip;
+        }
+
+        CommandHeader* header = reinterpret_cast<CommandHeader*>(&buffer[position & MASK]);
+        header->cmd = cmd;
+        header->length = length;
+        header->sequence = recordSequence;
+        header->param1 = param1;
+        header->param2 = param2;
+        uint8_t* data = reinterpret_cast<uint8_t*>(header + 1);
+        for (uint8_t i = 0; i < length; i++) {
+            data[i] = payload[i];
+        }
+
+        used += skip + size;
+        if (used > highWater) highWater = used;
+
+        // Record contents must be visible before the new head
+        __dmb();
+        head = position + size;
+        return true;
+    }
+
+    CommandRingStats CommandRing::getStats() const {
+        return { highWater, dropped };
+    }
+
+} // namespace commands
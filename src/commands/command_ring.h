@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstdint>
+#include "hardware/sync.h"
+
+namespace commands {
+
+    // Fixed part of every record in the command ring
+    struct CommandHeader {
+        uint8_t cmd;
+        uint8_t length;     // payload bytes following the header
+        uint16_t sequence;  // incremented for every send, a gap means commands were dropped
+        uint16_t param1;
+        uint16_t param2;
+    };
+    static_assert(sizeof(CommandHeader) == 8, "command records are aligned to the header size");
+
+    struct CommandRingStats {
+        uint32_t highWater;     // most bytes ever queued
+        uint32_t dropped;       // commands that did not fit
+    };
+
+    // Single producer, single consumer byte ring for variable-length commands.
+    //
+    // Records are a header followed by the payload, padded to 8 bytes and never split at the end
+    // of the buffer, so the consumer hands out pointers straight into the ring. The producer only
+    // writes head and the consumer only writes tail, both plain word stores ordered with __dmb().
+    class CommandRing {
+    public:
+        static constexpr uint32_t CAPACITY = 1024;  // bytes, must be a power of two
+        static constexpr uint8_t MAX_PAYLOAD = 255;
+        static constexpr uint8_t PAD = 0xFF;        // header of the unused bytes before a wrap
+
+        CommandRing();
+
+        // Producer: queue a record, all or nothing. Never waits for the consumer.
+        bool push(uint8_t cmd, uint16_t param1, uint16_t param2, const uint8_t* payload, uint8_t length);
+
+        /**
+         * @brief Consumer: hand every queued record to fn, then free them all at once
+         *
+         * fn is called as fn(const CommandHeader& header, const uint8_t* payload). The payload
+         * points into the ring and is only valid during the call.
+         *
+         * @return Number of records handled
+         */
+        template <typename Fn>
+        uint16_t drain(Fn fn) {
+            uint32_t end = head;
+            __dmb();
+
+            uint32_t cursor = tail;
+            uint16_t count = 0;
+            while (cursor != end) {
+                const CommandHeader* header = reinterpret_cast<const CommandHeader*>(&buffer[cursor & MASK]);
+                if (header->cmd == PAD) {
+                    cursor += CAPACITY - (cursor & MASK);
+                    continue;
+                }
+                fn(*header, reinterpret_cast<const uint8_t*>(header + 1));
+                cursor += recordSize(header->length);
+                count++;
+            }
+
+            // Records must be read before the producer may overwrite them
+            __dmb();
+            tail = cursor;
+            return count;
+        }
+
+        bool isEmpty() const { return head == tail; }
+        CommandRingStats getStats() const;
+
+    private:
+        static constexpr uint32_t MASK = CAPACITY - 1;
+        static_assert((CAPACITY & MASK) == 0, "CAPACITY must be a power of two");
+
+        alignas(8) uint8_t buffer[CAPACITY];
+        volatile uint32_t head;     // free running byte counters, written by one side each
+        volatile uint32_t tail;
+        uint16_t sequence;
+        uint32_t highWater;
+        uint32_t dropped;
+
+        static uint32_t recordSize(uint8_t length) { return (sizeof(CommandHeader) + length + 7) & ~7u; }
+    };
+
+} // namespace commands
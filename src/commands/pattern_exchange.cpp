@@ -0,0 +1,24 @@
+#include "pattern_exchange.h"
+#include "triple_buffer.h"
+
+namespace commands {
+
+    // One exchange per pattern slot, so edits to different slots never replace each other
+    static TripleBuffer<PatternEdit> patternExchanges[MAX_PATTERNS];
+
+    void sendPattern(uint8_t index, const common::Pattern& pattern, PatternApply apply) {
+        if (index >= MAX_PATTERNS) return;
+
+        TripleBuffer<PatternEdit>& exchange = patternExchanges[index];
+        PatternEdit& edit = exchange.back();
+        edit.pattern = pattern;
+        edit.apply = apply;
+        exchange.publish();
+    }
+
+    const PatternEdit* receivePattern(uint8_t index) {
+        if (index >= MAX_PATTERNS) return nullptr;
+        return patternExchanges[index].acquire();
+    }
+
+} // namespace commands
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstdint>
+#include "../common/const.h"
+#include "../common/pattern.h"
+
+namespace commands {
+
+    // When the sequencer core swaps in a published pattern
+    enum class PatternApply : uint8_t {
+        NEXT_TICK,  // at the next tick
+        NEXT_BAR,   // at the start of the next bar, immediately while stopped
+    };
+
+    // A complete pattern published by the UI core for one pattern slot
+    struct PatternEdit {
+        common::Pattern pattern;
+        PatternApply apply;
+    };
+
+    /**
+     * @brief Publish a complete pattern for a slot of the sequencer core
+     *
+     * The pattern is copied into a buffer the sequencer core does not read, then handed over
+     * with a single word store. Never blocks; a newer pattern for the same slot replaces one
+     * that has not been picked up yet.
+     */
+    void sendPattern(uint8_t index, const common::Pattern& pattern, PatternApply apply = PatternApply::NEXT_TICK);
+
+    /**
+     * @brief Take the newest pattern published for a slot
+     *
+     * Called on the sequencer core only. The edit stays valid until the next call for the same
+     * slot that returns a new one.
+     *
+     * @return The edit, or nullptr if nothing new was published
+     */
+    const PatternEdit* receivePattern(uint8_t index);
+
+} // namespace commands
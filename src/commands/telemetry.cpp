@@ -0,0 +1,21 @@
+#include "telemetry.h"
+#include "triple_buffer.h"
+
+namespace commands {
+
+    // Reverse channel from the sequencer core to the UI core
+    static TripleBuffer<Telemetry> telemetryExchange;
+
+    Telemetry& beginTelemetry() {
+        return telemetryExchange.back();
+    }
+
+    void publishTelemetry() {
+        telemetryExchange.publish();
+    }
+
+    const Telemetry* receiveTelemetry() {
+        return telemetryExchange.acquire();
+    }
+
+} // namespace commands
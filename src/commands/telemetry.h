@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+#include "../common/const.h"
+
+namespace commands {
+
+    // One bit per pattern slot
+    static_assert(MAX_PATTERNS <= 64, "pattern masks hold at most 64 slots");
+    using PatternMask = std::conditional_t<(MAX_PATTERNS <= 16), uint16_t,
+        std::conditional_t<(MAX_PATTERNS <= 32), uint32_t, uint64_t>>;
+
+    // Playback state of one pattern slot
+    struct PatternTelemetry {
+        uint16_t tick;      // position within the gate cycle
+        uint16_t length;    // gate cycle length in ticks
+        uint8_t note;       // note currently held, NO_NOTE if silent
+    };
+
+    // Snapshot of the sequencer core, published after every tick
+    struct Telemetry {
+        static constexpr uint8_t NO_NOTE = 0xFF;
+
+        uint32_t songTick;          // ticks since play
+        PatternMask usedPatterns;   // one bit per pattern slot in use
+        PatternMask activePatterns; // one bit per slot that is playing
+        PatternMask noteOns;        // slots that started a note on this tick
+        PatternMask noteOffs;       // slots that ended a note on this tick
+        uint16_t lateUs;            // how late the tick alarm fired
+        uint16_t lateMaxUs;
+        bool playing;
+        PatternTelemetry patterns[MAX_PATTERNS];
+    };
+
+    /**
+     * @brief Buffer for the next snapshot
+     *
+     * Called on the sequencer core only. Fill it completely, then call publishTelemetry().
+     */
+    Telemetry& beginTelemetry();
+
+    // Make the snapshot from beginTelemetry() the newest one, never blocks
+    void publishTelemetry();
+
+    /**
+     * @brief Take the newest snapshot
+     *
+     * Called on the UI core only. Snapshots published in between are skipped. The returned
+     * snapshot stays valid until the next call that returns a new one.
+     *
+     * @return The snapshot, or nullptr if nothing was published since the last call
+     */
+    const Telemetry* receiveTelemetry();
+
+} // namespace commands
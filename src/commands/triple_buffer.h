@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstdint>
+#include "hardware/sync.h"
+
+namespace commands {
+
+    // Lock-free single producer, single consumer hand-off of a whole value between the cores.
+    //
+    // The producer fills its private back buffer and publishes it by storing one word that holds
+    // the buffer index and a sequence number. The consumer claims the newest published buffer by
+    // storing its index and reading the published word again to confirm it. Of the three buffers
+    // one is always free for the producer, so neither side ever waits for the other.
+    //
+    // The RP2040 cores (Cortex-M0+) have no exclusive load/store, so the protocol only relies on
+    // aligned word loads and stores being atomic, with __dmb() ordering them against the buffer data.
+    template <typename T>
+    class TripleBuffer {
+    public:
+        TripleBuffer() :
+            published(packState(0, 0)),
+            acquired(1),
+            writeIndex(2),
+            writeSequence(0),
+            readSequence(0) {
+        }
+
+        // Producer: the private buffer to fill before publish()
+        T& back() { return buffers[writeIndex]; }
+
+        // Producer: make the back buffer the newest value and switch to a free one
+        void publish() {
+            // Buffer contents must be visible before the index that points at them
+            __dmb();
+            writeSequence++;
+            published = packState(writeIndex, writeSequence);
+            __dmb();
+
+            uint8_t reading = acquired;
+            if (reading != writeIndex) {
+                // Neither the buffer just published nor the one the consumer holds
+                writeIndex = 3 - writeIndex - reading;
+            }
+            else {
+                // The consumer already took the new buffer, both others are free
+                writeIndex = writeIndex == 2 ? 0 : writeIndex + 1;
+            }
+        }
+
+        /**
+         * @brief Consumer: claim the newest published value
+         *
+         * The returned buffer is not touched by the producer until the next successful acquire().
+         *
+         * @return The new value, or nullptr if nothing was published since the last call
+         */
+        const T* acquire() {
+            uint32_t state = published;
+            if (sequenceOf(state) == readSequence) return nullptr;
+
+            while (true) {
+                acquired = indexOf(state);
+                __dmb();
+                // The producer may have reused the buffer before it saw our claim, try the newer one
+                uint32_t confirm = published;
+                if (confirm == state) break;
+                state = confirm;
+            }
+            __dmb();
+
+            readSequence = sequenceOf(state);
+            return &buffers[indexOf(state)];
+        }
+
+    private:
+        T buffers[3];
+        volatile uint32_t published;    // written by the producer: index | sequence << 2
+        volatile uint8_t acquired;      // written by the consumer
+        uint8_t writeIndex;             // producer only
+        uint32_t writeSequence;         // producer only
+        uint32_t readSequence;          // consumer only
+
+        static uint32_t packState(uint8_t index, uint32_t sequence) { return index | (sequence << 2); }
+        static uint8_t indexOf(uint32_t state) { return state & 0x3; }
+        static uint32_t sequenceOf(uint32_t state) { return state >> 2; }
+    };
+
+} // namespace commands
@@ -1,3 +1,11 @@
+#pragma once
+
 namespace common {
     #define PPQN 24
-}
\ No newline at end of file
+
+    // Maximum number of patterns the sequencer plays at once, at most 64
+    // (can be overridden at build time, e.g. for benchmarks)
+#ifndef MAX_PATTERNS
+    #define MAX_PATTERNS 16
+#endif
+}
@@ -1,5 +1,5 @@
 #include "gate_set.h"
-#include <algorithm>
+#include "log.h"
 #include <cstdio>
 #include <map>
 
@@ -15,42 +15,99 @@ namespace common {
         return flankStringMap[flank];
     }
 
-    Flank getInitFlank(std::vector<bool> gates);
-
     // GateSet implementation
-    GateSet::GateSet(const std::vector<bool>& gates) :
-        gates(gates),
+    GateSet::GateSet(std::initializer_list<bool> gates) :
+        gates{},
+        risingEdges{},
+        fallingEdges{},
+        length(0),
         position(0),
         previousPosition(0),
-        flank(getInitFlank(gates))
+        flank(LOW)
     {
+        setGates(gates);
+
+        if (length == 0) return;
         printf("|");
-        for (auto gate : gates) {
-            printf("%s", gate ? "-" : "_");
+        for (uint16_t i = 0; i < length; i++) {
+            printf("%s", testBit(this->gates, i) ? "-" : "_");
+        }
+    }
+
+    void GateSet::setGates(std::initializer_list<bool> gates) {
+        for (auto& word : this->gates) {
+            word = 0;
+        }
+        length = 0;
+        for (bool gate : gates) {
+            if (length >= MAX_LENGTH) break;
+            if (gate) this->gates[length >> 5] |= 1u << (length & 0x1F);
+            length++;
+        }
+        updateEdges();
+        reset();
+    }
+
+    void GateSet::setGate(uint16_t position, bool gate) {
+        if (position >= length) return;
+        uint32_t bit = 1u << (position & 0x1F);
+        if (gate) {
+            gates[position >> 5] |= bit;
+        }
+        else {
+            gates[position >> 5] &= ~bit;
         }
+        updateEdges();
     }
 
-    const std::vector<bool>& GateSet::getGates() const {
-        return gates;
+    bool GateSet::getGateAt(uint16_t position) const {
+        if (position >= length) return false;
+        return testBit(gates, position);
     }
 
-    void GateSet::setGates(const std::vector<bool>& gates) {
-        this->gates = gates;
+    uint16_t GateSet::getLength() const {
+        return length;
     }
 
-    uint32_t GateSet::getLength() const {
-        return gates.size();
+    void GateSet::setLength(uint16_t length) {
+        if (length > MAX_LENGTH) length = MAX_LENGTH;
+        // Clear gates beyond the new length so they do not reappear when growing again
+        for (uint16_t i = length; i < this->length; i++) {
+            gates[i >> 5] &= ~(1u << (i & 0x1F));
+        }
+        this->length = length;
+        updateEdges();
+        if (position >= length) reset();
     }
 
-    void GateSet::setPosition(uint8_t position) {
-        if (position >= gates.size()) {
-            printf("GateSet::setPosition: position %d is out of bounds for gate set of size %d\n", position, gates.size());
+    void GateSet::setPosition(uint16_t position) {
+        if (length == 0) {
+            flank = LOW;
+            return;
+        }
+        if (position >= length) {
+            LOG_WARN("GateSet::setPosition: position %d is out of bounds for gate set of size %d\n", position, length);
         }
         this->previousPosition = this->position;
-        this->position = position % gates.size();
+        this->position = position % length;
+
+        uint16_t nextPosition = this->previousPosition + 1 == length ? 0 : this->previousPosition + 1;
+        if (this->position == nextPosition) {
+            // Advancing by one tick: the edge masks already hold the answer
+            if (testBit(risingEdges, this->position)) {
+                this->flank = RISING;
+            }
+            else if (testBit(fallingEdges, this->position)) {
+                this->flank = FALLING;
+            }
+            else {
+                this->flank = testBit(gates, this->position) ? HIGH : LOW;
+            }
+            return;
+        }
 
-        bool previousGate = this->gates[this->previousPosition];
-        bool currentGate = this->gates[this->position];
+        bool previousGate = testBit(gates, this->previousPosition);
+        bool currentGate = testBit(gates, this->position);
 
         if (!previousGate && currentGate) {
             this->flank = RISING;
@@ -66,7 +123,7 @@ namespace common {
         }
     }
 
-    uint8_t GateSet::getPosition() const {
+    uint16_t GateSet::getPosition() const {
         return position;
     }
 
@@ -77,31 +134,62 @@ namespace common {
     void GateSet::reset() {
         position = 0;
         previousPosition = 0;
-        flank = getInitFlank(this->gates);
+        // Empty sets are normal here (default construction), no need to report them
+        flank = length > 0 ? getInitFlank() : LOW;
     }
 
     bool GateSet::getGate() const {
-        return gates[position];
+        return length > 0 && testBit(gates, position);
     }
 
-    Flank getInitFlank(std::vector<bool> gates) {
-        if (gates.size() == 0) {
-            printf("GateSet::getInitFlank: no gates\n");
+    Flank GateSet::getInitFlank() const {
+        if (length == 0) {
+            LOG_WARN("GateSet::getInitFlank: no gates\n");
             return LOW;
         }
         else {
-            Flank result = gates[0] ? RISING : LOW;
+            Flank result = testBit(gates, 0) ? RISING : LOW;
             return result;
         }
     }
 
+    void GateSet::updateEdges() {
+        uint8_t usedWords = (length + 31) / 32;
+        // Position 0 follows the last position of the cycle
+        uint32_t carry = length > 0 ? (gates[(length - 1) >> 5] >> ((length - 1) & 0x1F)) & 1u : 0;
+
+        for (uint8_t w = 0; w < WORD_COUNT; w++) {
+            if (w >= usedWords) {
+                risingEdges[w] = 0;
+                fallingEdges[w] = 0;
+                continue;
+            }
+            uint32_t current = gates[w];
+            uint32_t previous = (current << 1) | carry;
+            carry = current >> 31;
+
+            risingEdges[w] = current & ~previous;
+            fallingEdges[w] = ~current & previous;
+        }
+
+        // Drop edges past the end of the pattern in the last used word
+        if (usedWords > 0 && (length & 0x1F) != 0) {
+            uint32_t validMask = (1u << (length & 0x1F)) - 1;
+            risingEdges[usedWords - 1] &= validMask;
+            fallingEdges[usedWords - 1] &= validMask;
+        }
+    }
+
     GateSet GateSet::createEuclidean(uint8_t numSteps, uint8_t numPulses, uint8_t rotation, uint32_t patternLength) {
         // Euclidean algorithm implementation (Bjorklund's algorithm)
-        std::vector<bool> pattern(numSteps, false);
+        // One bit per step, at most 255 steps
+        uint32_t pattern[8] = {};
 
         if (numPulses >= numSteps) {
             // If pulses >= steps, all steps are active
-            std::fill(pattern.begin(), pattern.end(), true);
+            for (uint16_t i = 0; i < numSteps; i++) {
+                pattern[i >> 5] |= 1u << (i & 0x1F);
+            }
         }
         else if (numPulses > 0) {
             // Calculate the spacing between pulses
@@ -110,21 +198,29 @@ namespace common {
                 bucket += numPulses;
                 if (bucket >= numSteps) {
                     bucket -= numSteps;
-                    pattern[(i + rotation) % numSteps] = true;
+                    uint16_t step = (i + rotation) % numSteps;
+                    pattern[step >> 5] |= 1u << (step & 0x1F);
                 }
             }
         }
 
         // Expand the pattern to fill the requested pattern length
-        std::vector<bool> expandedPattern(patternLength, false);
-        if (!pattern.empty()) {
-            uint32_t stepSize = patternLength / numSteps;
-            for (uint32_t i = 0; i < patternLength; i++) {
-                expandedPattern[i] = pattern[(i / stepSize) % numSteps];
+        GateSet result;
+        result.length = patternLength > MAX_LENGTH ? MAX_LENGTH : static_cast<uint16_t>(patternLength);
+        if (numSteps > 0) {
+            uint32_t stepSize = result.length / numSteps;
+            if (stepSize == 0) stepSize = 1;
+            for (uint16_t i = 0; i < result.length; i++) {
+                uint16_t step = (i / stepSize) % numSteps;
+                if (testBit(pattern, step)) {
+                    result.gates[i >> 5] |= 1u << (i & 0x1F);
+                }
             }
         }
+        result.updateEdges();
+        result.reset();
 
-        return GateSet(expandedPattern);
+        return result;
     }
 
 } // namespace common
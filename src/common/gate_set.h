@@ -1,7 +1,8 @@
 #pragma once
 
-#include <vector>
+#include <initializer_list>
 #include <cstdint>
+#include "const.h"
 
 namespace common {
 
@@ -12,24 +13,40 @@ namespace common {
         FALLING = 3
     };
 
+    char const* flankToString(Flank flank);
+
     // Class to represent a gate pattern (on/off values for each tick)
+    //
+    // Gates are packed into 32-bit words with a fixed capacity. Rising and falling edge masks
+    // are precomputed whenever the gates change, so advancing by one tick only tests bits.
     class GateSet {
     public:
-        GateSet(const std::vector<bool>& gates = {});
-        const std::vector<bool>& getGates() const;
-        void setGates(const std::vector<bool>& gates);
-        
+        // Maximum length of a gate set in ticks (16 quarter notes)
+        static constexpr uint16_t MAX_LENGTH = PPQN * 16;
+        static constexpr uint8_t WORD_COUNT = (MAX_LENGTH + 31) / 32;
+
+        GateSet(std::initializer_list<bool> gates = {});
+
+        void setGates(std::initializer_list<bool> gates);
+        void setGate(uint16_t position, bool gate);
+        bool getGateAt(uint16_t position) const;
+
         // Get the total length of the pattern in ticks
-        uint32_t getLength() const;
+        uint16_t getLength() const;
+        void setLength(uint16_t length);
+
+        void setPosition(uint16_t position);
+        uint16_t getPosition() const;
 
-        void setPosition(uint8_t position);
-        uint8_t getPosition() const;
-        
         // Check if a gate is active at the given tick position
         Flank getFlank() const;
 
         bool getGate() const;
 
+        // Edge masks, WORD_COUNT words with bit i set if the gate rises/falls at position i
+        const uint32_t* getRisingEdges() const { return risingEdges; }
+        const uint32_t* getFallingEdges() const { return fallingEdges; }
+
         void reset();
 
         /// Create a gate set based on the Euclidean algorithm (Bjorklund's algorithm)
@@ -37,15 +54,26 @@ namespace common {
         /// \param steps The total number of steps in the pattern
         /// \param pulses The number of pulses to distribute evenly
         /// \param rotation The rotation in steps to apply to the resulting pattern
-        /// \param patternLength The total length of the pattern in ticks
+        /// \param patternLength The total length of the pattern in ticks (clamped to MAX_LENGTH)
         ///
         /// \return A GateSet with the generated pattern
         static GateSet createEuclidean(uint8_t steps, uint8_t pulses, uint8_t rotation, uint32_t patternLength);
 
     private:
-        std::vector<bool> gates;
-        uint8_t position;
-        uint8_t previousPosition;
+        uint32_t gates[WORD_COUNT];
+        // Bit i is set if the gate rises/falls when moving from position i - 1 (wrapping) to i
+        uint32_t risingEdges[WORD_COUNT];
+        uint32_t fallingEdges[WORD_COUNT];
+        uint16_t length;
+        uint16_t position;
+        uint16_t previousPosition;
         Flank flank;
+
+        void updateEdges();
+        Flank getInitFlank() const;
+
+        static bool testBit(const uint32_t* words, uint16_t position) {
+            return (words[position >> 5] >> (position & 0x1F)) & 1u;
+        }
     };
 } // namespace common
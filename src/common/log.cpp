@@ -0,0 +1,121 @@
+#include "log.h"
+#include <cstdio>
+#include "hardware/sync.h"
+#include "hardware/timer.h"
+
+#if PICO_ON_DEVICE
+#include "pico/platform.h"
+#endif
+
+namespace common {
+
+    // One deferred log call, the format string stays in flash
+    struct LogRecord {
+        const char* format;
+        uint32_t timeUs;
+        uint32_t args[LOG_MAX_ARGS];
+        uint8_t level;
+    };
+
+    // Single producer, single consumer ring of records, one per core.
+    //
+    // Only code running on the owning core pushes, the UI loop on core 0 drains. Both indices are
+    // free running and written by one side each, ordered with __dmb() like the command ring.
+    // Log sites in interrupt handlers would be a second producer and are not supported.
+    struct LogRing {
+        static constexpr uint32_t CAPACITY = 32;    // records, must be a power of two
+        static constexpr uint32_t MASK = CAPACITY - 1;
+        static_assert((CAPACITY & MASK) == 0, "CAPACITY must be a power of two");
+
+        LogRecord records[CAPACITY];
+        volatile uint32_t head;
+        volatile uint32_t tail;
+        uint32_t highWater;
+        volatile uint32_t dropped;
+        uint32_t reportedDropped;   // consumer only
+    };
+
+    static LogRing rings[2];
+
+    static const char LEVEL_NAMES[] = { '-', 'E', 'W', 'I', 'D' };
+
+    void logPush(uint8_t level, const char* format, const uint32_t* args) {
+#if PICO_ON_DEVICE
+        LogRing& ring = rings[get_core_num()];
+#else
+        LogRing& ring = rings[0];
+#endif
+        uint32_t position = ring.head;
+        uint32_t used = position - ring.tail;
+        if (used >= LogRing::CAPACITY) {
+            ring.dropped = ring.dropped + 1;
+            return;
+        }
+
+        LogRecord& record = ring.records[position & LogRing::MASK];
+        record.format = format;
+        record.timeUs = time_us_32();
+        for (uint8_t i = 0; i < LOG_MAX_ARGS; i++) {
+            record.args[i] = args[i];
+        }
+        record.level = level;
+
+        if (used + 1 > ring.highWater) ring.highWater = used + 1;
+
+        // Record contents must be visible before the new head
+        __dmb();
+        ring.head = position + 1;
+    }
+
+    uint16_t drainLog(uint16_t maxRecords) {
+        uint16_t count = 0;
+        while (count < maxRecords) {
+            // Of the two oldest records print the earlier one, so the cores interleave in time order
+            LogRing* next = nullptr;
+            uint8_t core = 0;
+            for (uint8_t i = 0; i < 2; i++) {
+                LogRing& ring = rings[i];
+                if (ring.tail == ring.head) continue;
+                __dmb();
+                if (next == nullptr ||
+                    static_cast<int32_t>(ring.records[ring.tail & LogRing::MASK].timeUs -
+                        next->records[next->tail & LogRing::MASK].timeUs) < 0) {
+                    next = &ring;
+                    core = i;
+                }
+            }
+            if (next == nullptr) break;
+
+            const LogRecord& record = next->records[next->tail & LogRing::MASK];
+            uint8_t level = record.level < sizeof(LEVEL_NAMES) ? record.level : 0;
+            printf("%u.%03u %c%u ", (unsigned)(record.timeUs / 1000000),
+                (unsigned)(record.timeUs / 1000 % 1000), LEVEL_NAMES[level], (unsigned)core);
+            printf(record.format, record.args[0], record.args[1], record.args[2], record.args[3]);
+
+            // Record must be read before the producer may overwrite it
+            __dmb();
+            next->tail = next->tail + 1;
+            count++;
+        }
+
+        for (uint8_t i = 0; i < 2; i++) {
+            LogRing& ring = rings[i];
+            uint32_t dropped = ring.dropped;
+            if (dropped != ring.reportedDropped) {
+                printf("Log: %u records dropped on core %u\n", (unsigned)(dropped - ring.reportedDropped), (unsigned)i);
+                ring.reportedDropped = dropped;
+            }
+        }
+        return count;
+    }
+
+    LogStats getLogStats() {
+        LogStats stats = { 0, 0 };
+        for (const LogRing& ring : rings) {
+            if (ring.highWater > stats.highWater) stats.highWater = ring.highWater;
+            stats.dropped += ring.dropped;
+        }
+        return stats;
+    }
+
+} // namespace common
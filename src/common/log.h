@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+
+// Log levels, sites above GENSEQ_LOG_LEVEL are compiled out including their arguments
+#define LOG_LEVEL_NONE 0
+#define LOG_LEVEL_ERROR 1
+#define LOG_LEVEL_WARN 2
+#define LOG_LEVEL_INFO 3
+#define LOG_LEVEL_DEBUG 4
+
+#ifndef GENSEQ_LOG_LEVEL
+#define GENSEQ_LOG_LEVEL LOG_LEVEL_INFO
+#endif
+
+namespace common {
+
+    static constexpr uint8_t LOG_MAX_ARGS = 4;
+
+    struct LogStats {
+        uint32_t highWater;     // most records ever queued on one core
+        uint32_t dropped;       // records that did not fit, summed over both cores
+    };
+
+    // Queue a record on the calling core's ring. Never blocks, drops the record if the ring is full.
+    void logPush(uint8_t level, const char* format, const uint32_t* args);
+
+    /**
+     * @brief Format and print queued records over stdio, oldest core 0 records first
+     *
+     * Meant for the idle part of the UI loop, printing blocks until the UART takes the text.
+     *
+     * @return Number of records printed
+     */
+    uint16_t drainLog(uint16_t maxRecords);
+
+    LogStats getLogStats();
+
+    // Deferred printf: only the format pointer and up to LOG_MAX_ARGS integer arguments are queued,
+    // so the format must be a string literal and %s is not supported
+    template <typename... Args>
+    inline void logWrite(uint8_t level, const char* format, Args... args) {
+        static_assert(sizeof...(Args) <= LOG_MAX_ARGS, "too many log arguments");
+        static_assert(((std::is_integral<Args>::value || std::is_enum<Args>::value) && ...),
+            "log arguments must be integers");
+        uint32_t values[LOG_MAX_ARGS] = { static_cast<uint32_t>(args)... };
+        logPush(level, format, values);
+    }
+
+} // namespace common
+
+#if GENSEQ_LOG_LEVEL >= LOG_LEVEL_ERROR
+#define LOG_ERROR(...) common::logWrite(LOG_LEVEL_ERROR, __VA_ARGS__)
+#else
+#define LOG_ERROR(...) do {} while (0)
+#endif
+
+#if GENSEQ_LOG_LEVEL >= LOG_LEVEL_WARN
+#define LOG_WARN(...) common::logWrite(LOG_LEVEL_WARN, __VA_ARGS__)
+#else
+#define LOG_WARN(...) do {} while (0)
+#endif
+
+#if GENSEQ_LOG_LEVEL >= LOG_LEVEL_INFO
+#define LOG_INFO(...) common::logWrite(LOG_LEVEL_INFO, __VA_ARGS__)
+#else
+#define LOG_INFO(...) do {} while (0)
+#endif
+
+#if GENSEQ_LOG_LEVEL >= LOG_LEVEL_DEBUG
+#define LOG_DEBUG(...) common::logWrite(LOG_LEVEL_DEBUG, __VA_ARGS__)
+#else
+#define LOG_DEBUG(...) do {} while (0)
+#endif
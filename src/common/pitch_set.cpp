@@ -1,25 +1,42 @@
 #include "pitch_set.h"
-#include <cstdio>
+#include "log.h"
 
 namespace common {
 
     // PitchSet implementation
-    PitchSet::PitchSet(const std::vector<uint8_t>& pitches) : pitches(pitches), position(0), previousPosition(0) {}
+    PitchSet::PitchSet(std::initializer_list<uint8_t> pitches) : pitches{}, length(0), position(0), previousPosition(0) {
+        setPitches(pitches);
+    }
+
+    void PitchSet::setPitches(std::initializer_list<uint8_t> pitches) {
+        setPitches(pitches.begin(), static_cast<uint8_t>(pitches.size() > MAX_LENGTH ? MAX_LENGTH : pitches.size()));
+    }
+
+    void PitchSet::setPitches(const uint8_t* pitches, uint8_t count) {
+        if (count > MAX_LENGTH) count = MAX_LENGTH;
+        for (uint8_t i = 0; i < count; i++) {
+            this->pitches[i] = pitches[i];
+        }
+        this->length = count;
+        if (this->position >= count) this->position = 0;
+        if (this->previousPosition >= count) this->previousPosition = 0;
+    }
 
-    const std::vector<uint8_t>& PitchSet::getPitches() const {
-        return this->pitches;
+    uint8_t PitchSet::getPitchAt(uint8_t position) const {
+        return position < length ? this->pitches[position] : 0;
     }
 
-    void PitchSet::setPitches(const std::vector<uint8_t>& pitches) {
-        this->pitches = pitches;
+    uint8_t PitchSet::getLength() const {
+        return this->length;
     }
 
     void PitchSet::setPosition(uint8_t position) {
-        if(position >= pitches.size()) {
-            printf("PitchSet::setPosition: position %d is out of bounds for pitch set of size %d\n", position, pitches.size());
+        if (length == 0) return;
+        if(position >= length) {
+            LOG_WARN("PitchSet::setPosition: position %d is out of bounds for pitch set of size %d\n", position, length);
         }
         this->previousPosition = this->position;
-        this->position = position % pitches.size();
+        this->position = position % length;
     }
 
     uint8_t PitchSet::getPosition() const {
@@ -1,6 +1,6 @@
 #pragma once
 
-#include <vector>
+#include <initializer_list>
 #include <cstdint>
 
 namespace common {
@@ -8,9 +8,15 @@ namespace common {
     // Class to represent a set of pitches (notes)
     class PitchSet {
     public:
-        PitchSet(const std::vector<uint8_t>& pitches = {});
-        const std::vector<uint8_t>& getPitches() const;
-        void setPitches(const std::vector<uint8_t>& pitches);
+        // Maximum number of pitches, stored inline
+        static constexpr uint8_t MAX_LENGTH = 32;
+
+        PitchSet(std::initializer_list<uint8_t> pitches = {});
+
+        void setPitches(std::initializer_list<uint8_t> pitches);
+        void setPitches(const uint8_t* pitches, uint8_t count);
+        uint8_t getPitchAt(uint8_t position) const;
+        uint8_t getLength() const;
 
         void setPosition(uint8_t position);
         uint8_t getPosition() const;
@@ -21,7 +27,8 @@ namespace common {
         void reset();
 
     private:
-        std::vector<uint8_t> pitches;
+        uint8_t pitches[MAX_LENGTH];
+        uint8_t length;
         uint8_t position;
         uint8_t previousPosition;
     };
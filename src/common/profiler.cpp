@@ -0,0 +1,113 @@
+#include "profiler.h"
+#include <cstdio>
+
+#if PICO_ON_DEVICE
+#include "hardware/structs/systick.h"
+#include "hardware/clocks.h"
+#include "pico/platform.h"
+#include "pico/time.h"
+#else
+#include <chrono>
+#endif
+
+namespace common {
+
+    static ProfileZone* zones[ProfileZone::MAX_ZONES];
+    static uint8_t zoneCount = 0;
+    static uint64_t lastDumpUs = 0;
+
+    static uint64_t profileTimeUs() {
+#if PICO_ON_DEVICE
+        return time_us_64();
+#else
+        return std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+    }
+
+    static uint32_t cyclesPerUs() {
+#if PICO_ON_DEVICE
+        return clock_get_hz(clk_sys) / 1000000;
+#else
+        return 1000;
+#endif
+    }
+
+    ProfileZone::ProfileZone(const char* name) :
+        name(name),
+        core(0),
+        count(0),
+        minCycles(UINT32_MAX),
+        maxCycles(0),
+        totalCycles(0) {
+        if (zoneCount < MAX_ZONES) {
+            zones[zoneCount++] = this;
+        }
+    }
+
+    void ProfileZone::record(uint32_t cycles) {
+#if PICO_ON_DEVICE
+        core = get_core_num();
+#endif
+        count++;
+        totalCycles += cycles;
+        if (cycles < minCycles) minCycles = cycles;
+        if (cycles > maxCycles) maxCycles = cycles;
+    }
+
+    void ProfileZone::reset() {
+        count = 0;
+        minCycles = UINT32_MAX;
+        maxCycles = 0;
+        totalCycles = 0;
+    }
+
+    uint32_t profileCycles() {
+#if PICO_ON_DEVICE
+        // SysTick counts down, flip it so differences come out positive
+        return ~systick_hw->cvr & PROFILE_CYCLE_MASK;
+#else
+        return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+    }
+
+    void initProfilerCore() {
+#if PICO_ON_DEVICE
+        systick_hw->csr = 0;
+        systick_hw->rvr = PROFILE_CYCLE_MASK;
+        systick_hw->cvr = 0;
+        // Enable, no interrupt, processor clock
+        systick_hw->csr = 0x5;
+#endif
+        if (lastDumpUs == 0) lastDumpUs = profileTimeUs();
+    }
+
+    void dumpProfileZones() {
+        uint64_t nowUs = profileTimeUs();
+        uint64_t elapsedUs = nowUs - lastDumpUs;
+        lastDumpUs = nowUs;
+        uint32_t perUs = cyclesPerUs();
+
+        printf("Profile: %u zones over %uus, %u cycles/us\n",
+            (unsigned)zoneCount, (unsigned)elapsedUs, (unsigned)perUs);
+        printf("%-24s %4s %8s %8s %8s %8s %6s\n", "zone", "core", "calls", "min", "mean", "max", "load%");
+        for (uint8_t i = 0; i < zoneCount; i++) {
+            ProfileZone& zone = *zones[i];
+            if (zone.count == 0) {
+                printf("%-24s %4s %8u\n", zone.name, "-", 0u);
+                continue;
+            }
+            uint32_t mean = static_cast<uint32_t>(zone.totalCycles / zone.count);
+            uint32_t loadPermille = elapsedUs > 0
+                ? static_cast<uint32_t>(zone.totalCycles / perUs * 1000 / elapsedUs)
+                : 0;
+            printf("%-24s %4u %8u %8u %8u %8u %4u.%u\n", zone.name, (unsigned)zone.core,
+                (unsigned)zone.count, (unsigned)zone.minCycles, (unsigned)mean, (unsigned)zone.maxCycles,
+                (unsigned)(loadPermille / 10), (unsigned)(loadPermille % 10));
+            // Each dump covers the time since the previous one
+            zone.reset();
+        }
+    }
+
+} // namespace common
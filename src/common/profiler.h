@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstdint>
+
+// Profiling zones, set to 0 to compile them out
+#ifndef GENSEQ_PROFILE
+#define GENSEQ_PROFILE 1
+#endif
+
+namespace common {
+
+    // Timing statistics of one named code section.
+    //
+    // Zones are defined at file scope, so they register themselves during static initialisation
+    // while only core 0 runs, and their table never changes afterwards. Each zone is meant to be
+    // entered from one core only; dumpProfileZones() may read and reset it from the other core, so
+    // figures of a zone that is updated at that moment can be off by one call.
+    class ProfileZone {
+    public:
+        static constexpr uint8_t MAX_ZONES = 32;
+
+        explicit ProfileZone(const char* name);
+
+        void record(uint32_t cycles);
+        void reset();
+
+        const char* getName() const { return name; }
+
+    private:
+        friend void dumpProfileZones();
+
+        const char* name;
+        uint8_t core;
+        uint32_t count;
+        uint32_t minCycles;
+        uint32_t maxCycles;
+        uint64_t totalCycles;
+    };
+
+    /**
+     * @brief Current value of the cycle counter
+     *
+     * On the RP2040 this is the core's 24 bit SysTick running at the system clock, so sections
+     * longer than 2^24 cycles (134 ms at 125 MHz) wrap. On the host it counts nanoseconds.
+     */
+    uint32_t profileCycles();
+
+#if PICO_ON_DEVICE
+    static constexpr uint32_t PROFILE_CYCLE_MASK = 0x00FFFFFF;
+#else
+    static constexpr uint32_t PROFILE_CYCLE_MASK = 0xFFFFFFFF;
+#endif
+
+    // Start the cycle counter of the calling core, each core has its own SysTick
+    void initProfilerCore();
+
+    // Print all zones over stdio (calls, min/mean/max cycles, share of time) and start over
+    void dumpProfileZones();
+
+    // Records the cycles between construction and destruction into a zone
+    class ProfileScope {
+    public:
+        explicit ProfileScope(ProfileZone& zone) : zone(zone), start(profileCycles()) {}
+        ~ProfileScope() { zone.record((profileCycles() - start) & PROFILE_CYCLE_MASK); }
+
+    private:
+        ProfileZone& zone;
+        uint32_t start;
+    };
+
+} // namespace common
+
+#if GENSEQ_PROFILE
+#define PROFILE_CONCAT_(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_(a, b)
+// Define a zone at file scope: PROFILE_ZONE(sequencerUpdateZone, "Sequencer::update");
+#define PROFILE_ZONE(zone, name) static common::ProfileZone zone(name)
+// Time the rest of the enclosing block into a zone
+#define PROFILE_SCOPE(zone) common::ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(zone)
+#else
+#define PROFILE_ZONE(zone, name) static_assert(true, "")
+#define PROFILE_SCOPE(zone) do {} while (0)
+#endif
@@ -1,24 +1,40 @@
 #include "velocity_set.h"
-#include <cstdio>
+#include "log.h"
 
 namespace common {
 
     // VelocitySet implementation
-    VelocitySet::VelocitySet(const std::vector<uint8_t>& velocities) : velocities(velocities), position(0) {}
+    VelocitySet::VelocitySet(std::initializer_list<uint8_t> velocities) : velocities{}, length(0), position(0) {
+        setVelocities(velocities);
+    }
+
+    void VelocitySet::setVelocities(std::initializer_list<uint8_t> velocities) {
+        setVelocities(velocities.begin(), static_cast<uint8_t>(velocities.size() > MAX_LENGTH ? MAX_LENGTH : velocities.size()));
+    }
+
+    void VelocitySet::setVelocities(const uint8_t* velocities, uint8_t count) {
+        if (count > MAX_LENGTH) count = MAX_LENGTH;
+        for (uint8_t i = 0; i < count; i++) {
+            this->velocities[i] = velocities[i];
+        }
+        length = count;
+        if (position >= count) position = 0;
+    }
 
-    const std::vector<uint8_t>& VelocitySet::getVelocities() const {
-        return velocities;
+    uint8_t VelocitySet::getVelocityAt(uint8_t position) const {
+        return position < length ? velocities[position] : 0;
     }
 
-    void VelocitySet::setVelocities(const std::vector<uint8_t>& velocities) {
-        this->velocities = velocities;
+    uint8_t VelocitySet::getLength() const {
+        return length;
     }
 
     void VelocitySet::setPosition(uint8_t position) {
-        if(position >= velocities.size()) {
-            printf("VelocitySet::setPosition: position %d is out of bounds for velocity set of size %d\n", position, velocities.size());
+        if (length == 0) return;
+        if(position >= length) {
+            LOG_WARN("VelocitySet::setPosition: position %d is out of bounds for velocity set of size %d\n", position, length);
         }
-        this->position = position % velocities.size();
+        this->position = position % length;
     }
 
     uint8_t VelocitySet::getPosition() const {
@@ -1,6 +1,6 @@
 #pragma once
 
-#include <vector>
+#include <initializer_list>
 #include <cstdint>
 
 namespace common {
@@ -8,9 +8,15 @@ namespace common {
     // Class to represent a set of velocities
     class VelocitySet {
     public:
-        VelocitySet(const std::vector<uint8_t>& velocities = {});
-        const std::vector<uint8_t>& getVelocities() const;
-        void setVelocities(const std::vector<uint8_t>& velocities);
+        // Maximum number of velocities, stored inline
+        static constexpr uint8_t MAX_LENGTH = 32;
+
+        VelocitySet(std::initializer_list<uint8_t> velocities = {});
+
+        void setVelocities(std::initializer_list<uint8_t> velocities);
+        void setVelocities(const uint8_t* velocities, uint8_t count);
+        uint8_t getVelocityAt(uint8_t position) const;
+        uint8_t getLength() const;
 
         void setPosition(uint8_t position);
         uint8_t getPosition() const;
@@ -20,7 +26,8 @@ namespace common {
         void reset();
 
     private:
-        std::vector<uint8_t> velocities;
+        uint8_t velocities[MAX_LENGTH];
+        uint8_t length;
         uint8_t position;
     };
 
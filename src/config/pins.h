@@ -17,6 +17,12 @@
 // POTENTIOMETER (ADC0)
 #define POT_PIN 27
 
+// LCD (20x4 HD44780 behind an I2C backpack)
+#define LCD_I2C i2c0
+#define LCD_I2C_ADDR 0x27
+#define LCD_SDA_PIN 4
+#define LCD_SCL_PIN 5
+
 // UART MIDI
 #define MIDI_UART uart1    // Using UART1 for MIDI
 #define MIDI_UART_PIN_TX 8 // MIDI_UART_TX
@@ -1,6 +1,7 @@
 #include <stdio.h>
 #include "pico/stdio.h"
 #include "pico/multicore.h"
+#include "hardware/i2c.h"
 #include "sequencer/sequencer.h"
 #include "ui/ui.h"
 #include "config/pins.h"
@@ -31,7 +32,11 @@ int main()
         buttonPins,
         LED_PIN,
         LED_MATRIX_PIN,
-        POT_PIN);
+        POT_PIN,
+        LCD_I2C,
+        LCD_I2C_ADDR,
+        LCD_SDA_PIN,
+        LCD_SCL_PIN);
 
     // This should never be reached
     printf("GenSeq MIDI Sequencer ended.\n");
@@ -0,0 +1,74 @@
+#include "midi_encoder.h"
+#include "midi_messages.h"
+
+namespace sequencer {
+
+    MidiEncoder::MidiEncoder() :
+        runningStatus(true),
+        noteOffAsNoteOn(true),
+        lastStatus(0) {
+    }
+
+    void MidiEncoder::setRunningStatus(bool enabled) {
+        runningStatus = enabled;
+        reset();
+    }
+
+    bool MidiEncoder::isRunningStatus() const {
+        return runningStatus;
+    }
+
+    void MidiEncoder::setNoteOffAsNoteOn(bool enabled) {
+        noteOffAsNoteOn = enabled;
+    }
+
+    bool MidiEncoder::isNoteOffAsNoteOn() const {
+        return noteOffAsNoteOn;
+    }
+
+    uint8_t MidiEncoder::encodeNoteOn(uint8_t channelIndex, uint8_t note, uint8_t velocity, uint8_t* out) {
+        uint8_t status = midi::ChannelVoiceMessage::NOTE_ON | (channelIndex & 0x0F);
+        return encode(status, note & 0x7F, velocity & 0x7F, out);
+    }
+
+    uint8_t MidiEncoder::encodeNoteOff(uint8_t channelIndex, uint8_t note, uint8_t* out) {
+        uint8_t noteOnStatus = midi::ChannelVoiceMessage::NOTE_ON | (channelIndex & 0x0F);
+        if (runningStatus && noteOffAsNoteOn && lastStatus == noteOnStatus) {
+            // Note on with velocity 0 is a note off and keeps the status running
+            return encode(noteOnStatus, note & 0x7F, 0, out);
+        }
+        uint8_t status = midi::ChannelVoiceMessage::NOTE_OFF | (channelIndex & 0x0F);
+        return encode(status, note & 0x7F, 0, out);
+    }
+
+    void MidiEncoder::onSystemMessage(uint8_t status) {
+        switch (status) {
+        case midi::SystemRealTimeMessage::TIMING_CLOCK:
+        case midi::SystemRealTimeMessage::ACTIVE_SENSING:
+            // Real-time bytes may be interleaved anywhere and leave running status intact
+            break;
+        default:
+            // System common messages cancel running status. Transport messages (start, stop,
+            // continue, reset) resend it as well, so a receiver that was reset picks it up again.
+            reset();
+            break;
+        }
+    }
+
+    void MidiEncoder::reset() {
+        lastStatus = 0;
+    }
+
+    uint8_t MidiEncoder::encode(uint8_t status, uint8_t data1, uint8_t data2, uint8_t* out) {
+        uint8_t length = 0;
+        if (!runningStatus || status != lastStatus) {
+            out[length++] = status;
+        }
+        out[length++] = data1;
+        out[length++] = data2;
+
+        lastStatus = runningStatus ? status : 0;
+        return length;
+    }
+
+} // namespace sequencer
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstdint>
+
+namespace sequencer {
+
+    // Encodes outgoing MIDI messages with running status.
+    //
+    // A channel message whose status byte equals the last one sent goes out without it.
+    // Note offs can be sent as note on with velocity 0 when that keeps a note on status running.
+    class MidiEncoder {
+    public:
+        static constexpr uint8_t MAX_MESSAGE_LENGTH = 3;
+
+        MidiEncoder();
+
+        void setRunningStatus(bool enabled);
+        bool isRunningStatus() const;
+
+        void setNoteOffAsNoteOn(bool enabled);
+        bool isNoteOffAsNoteOn() const;
+
+        /**
+         * @brief Encode a note on message
+         *
+         * @param out Buffer of at least MAX_MESSAGE_LENGTH bytes
+         * @return Number of bytes written to out
+         */
+        uint8_t encodeNoteOn(uint8_t channelIndex, uint8_t note, uint8_t velocity, uint8_t* out);
+
+        /**
+         * @brief Encode a note off message
+         *
+         * Sent as note on with velocity 0 if that status is currently running on the channel.
+         *
+         * @param out Buffer of at least MAX_MESSAGE_LENGTH bytes
+         * @return Number of bytes written to out
+         */
+        uint8_t encodeNoteOff(uint8_t channelIndex, uint8_t note, uint8_t* out);
+
+        // Track a system message (0xF0-0xFF) that is sent as is
+        void onSystemMessage(uint8_t status);
+
+        // Forget the running status, the next channel message is sent with its status byte
+        void reset();
+
+    private:
+        bool runningStatus;
+        bool noteOffAsNoteOn;
+        uint8_t lastStatus; // 0 while no status is running
+
+        uint8_t encode(uint8_t status, uint8_t data1, uint8_t data2, uint8_t* out);
+    };
+
+} // namespace sequencer
@@ -0,0 +1,83 @@
+#include "midi_tx_queue.h"
+#include "hardware/irq.h"
+#include "hardware/sync.h"
+
+namespace sequencer {
+
+    // The UART IRQ handler carries no user data, so the queue owning the UART is kept here
+    static MidiTxQueue* activeQueue = nullptr;
+
+    MidiTxQueue::MidiTxQueue() :
+        uart(nullptr),
+        buffer{},
+        head(0),
+        tail(0),
+        stats{} {
+    }
+
+    void MidiTxQueue::init(uart_inst_t* uart) {
+        this->uart = uart;
+        activeQueue = this;
+
+        uart_set_irq_enables(uart, false, false);
+        uint irq = UART0_IRQ + uart_get_index(uart);
+        irq_set_exclusive_handler(irq, uartIrqHandler);
+        irq_set_enabled(irq, true);
+    }
+
+    bool MidiTxQueue::push(const uint8_t* data, uint8_t length) {
+        uint16_t used = static_cast<uint16_t>(head - tail);
+        if (CAPACITY - used < length) {
+            stats.overflows++;
+            return false;
+        }
+
+        uint16_t position = head;
+        for (uint8_t i = 0; i < length; i++) {
+            buffer[(position + i) & INDEX_MASK] = data[i];
+        }
+        // Publish the bytes before moving head
+        __dmb();
+        head = static_cast<uint16_t>(position + length);
+
+        used += length;
+        if (used > stats.highWater) stats.highWater = used;
+
+        // Start the transfer if the interrupt is idle (it only runs while bytes are waiting)
+        uint32_t irqState = save_and_disable_interrupts();
+        drain();
+        restore_interrupts(irqState);
+        return true;
+    }
+
+    uint16_t MidiTxQueue::size() const {
+        return static_cast<uint16_t>(head - tail);
+    }
+
+    MidiTxStats MidiTxQueue::getStats() const {
+        return stats;
+    }
+
+    void MidiTxQueue::resetStats() {
+        stats = {};
+    }
+
+    void MidiTxQueue::drain() {
+        uint16_t position = tail;
+        while (position != head && uart_is_writable(uart)) {
+            uart_putc_raw(uart, static_cast<char>(buffer[position & INDEX_MASK]));
+            position++;
+        }
+        tail = position;
+
+        // The TX interrupt fires when the UART FIFO runs low; keep it enabled only while bytes wait
+        uart_set_irq_enables(uart, false, position != head);
+    }
+
+    void MidiTxQueue::uartIrqHandler() {
+        if (activeQueue) {
+            activeQueue->drain();
+        }
+    }
+
+} // namespace sequencer
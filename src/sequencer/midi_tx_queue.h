@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstdint>
+#include "hardware/uart.h"
+
+namespace sequencer {
+
+    // Fill level statistics of the MIDI transmit queue
+    struct MidiTxStats {
+        uint16_t highWater;     // most bytes queued at once since the last reset
+        uint32_t overflows;     // messages dropped because the queue was full
+    };
+
+    // Buffered MIDI UART output.
+    //
+    // Messages are copied into a single-producer/single-consumer ring and drained into the UART
+    // FIFO by the UART TX interrupt, so sending never waits for the 31250 baud wire. The producer
+    // only moves head, the IRQ only moves tail.
+    class MidiTxQueue {
+    public:
+        static constexpr uint16_t CAPACITY = 256; // must be a power of two
+
+        MidiTxQueue();
+
+        /**
+         * @brief Attach the queue to the UART and install the TX interrupt handler
+         *
+         * The IRQ is enabled on the calling core, so this has to run on the core
+         * that sends MIDI.
+         */
+        void init(uart_inst_t* uart);
+
+        /**
+         * @brief Queue a complete MIDI message
+         *
+         * The message is queued as a whole or not at all, so a full queue never
+         * leaves a truncated message on the wire.
+         *
+         * @return false if the message did not fit and was dropped
+         */
+        bool push(const uint8_t* data, uint8_t length);
+
+        uint16_t size() const;
+
+        MidiTxStats getStats() const;
+        void resetStats();
+
+    private:
+        static constexpr uint16_t INDEX_MASK = CAPACITY - 1;
+        static_assert((CAPACITY & INDEX_MASK) == 0, "MidiTxQueue::CAPACITY must be a power of two");
+
+        uart_inst_t* uart;
+        uint8_t buffer[CAPACITY];
+        volatile uint16_t head;
+        volatile uint16_t tail;
+        MidiTxStats stats;
+
+        void drain();
+
+        static void uartIrqHandler();
+    };
+
+} // namespace sequencer
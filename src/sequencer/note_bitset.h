@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstdint>
+
+namespace sequencer {
+
+    // One bit per MIDI channel and note (16 x 128 bits = 256 bytes).
+    // Iteration only visits set bits, so scanning for sounding notes costs one step per word
+    // plus one per note that is actually on.
+    class NoteBitset {
+    public:
+        static constexpr uint8_t CHANNELS = 16;
+        static constexpr uint8_t NOTES = 128;
+
+        NoteBitset() : words{} {}
+
+        void set(uint8_t channel, uint8_t note) {
+            words[channel & 0x0F][(note & 0x7F) >> 5] |= bit(note);
+        }
+
+        void clear(uint8_t channel, uint8_t note) {
+            words[channel & 0x0F][(note & 0x7F) >> 5] &= ~bit(note);
+        }
+
+        bool test(uint8_t channel, uint8_t note) const {
+            return (words[channel & 0x0F][(note & 0x7F) >> 5] & bit(note)) != 0;
+        }
+
+        void reset() {
+            for (auto& channelWords : words) {
+                for (auto& word : channelWords) {
+                    word = 0;
+                }
+            }
+        }
+
+        // Number of set notes
+        uint16_t count() const {
+            uint16_t result = 0;
+            for (const auto& channelWords : words) {
+                for (uint32_t word : channelWords) {
+                    result += __builtin_popcount(word);
+                }
+            }
+            return result;
+        }
+
+        /**
+         * @brief Call fn(channel, note) for every set note
+         *
+         * Each word is copied before it is walked, so fn may clear the note it is called for.
+         */
+        template <typename Fn>
+        void forEach(Fn fn) const {
+            for (uint8_t channel = 0; channel < CHANNELS; channel++) {
+                for (uint8_t wordIndex = 0; wordIndex < WORDS_PER_CHANNEL; wordIndex++) {
+                    uint32_t word = words[channel][wordIndex];
+                    while (word) {
+                        uint8_t note = static_cast<uint8_t>((wordIndex << 5) | __builtin_ctz(word));
+                        word &= word - 1;
+                        fn(channel, note);
+                    }
+                }
+            }
+        }
+
+    private:
+        static constexpr uint8_t WORDS_PER_CHANNEL = NOTES / 32;
+
+        uint32_t words[CHANNELS][WORDS_PER_CHANNEL];
+
+        static uint32_t bit(uint8_t note) {
+            return 1u << (note & 0x1F);
+        }
+    };
+
+} // namespace sequencer
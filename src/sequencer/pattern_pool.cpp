@@ -0,0 +1,40 @@
+#include "pattern_pool.h"
+
+namespace sequencer {
+
+    PatternPool::PatternPool() :
+        used{},
+        freeCount(CAPACITY) {
+        // Hand out the lowest slots first
+        for (uint8_t i = 0; i < CAPACITY; i++) {
+            freeList[i] = CAPACITY - 1 - i;
+        }
+    }
+
+    uint8_t PatternPool::allocate(const common::Pattern& pattern) {
+        if (freeCount == 0) return INVALID_INDEX;
+
+        uint8_t index = freeList[--freeCount];
+        slots[index] = pattern;
+        used[index] = true;
+        return index;
+    }
+
+    bool PatternPool::allocateAt(uint8_t index, const common::Pattern& pattern) {
+        if (index >= CAPACITY || used[index]) return false;
+
+        // Take the slot out of the free list, keeping the order of the others
+        for (uint8_t i = 0; i < freeCount; i++) {
+            if (freeList[i] != index) continue;
+            for (uint8_t j = i + 1; j < freeCount; j++) {
+                freeList[j - 1] = freeList[j];
+            }
+            freeCount--;
+            break;
+        }
+        slots[index] = pattern;
+        used[index] = true;
+        return true;
+    }
+
+} // namespace sequencer
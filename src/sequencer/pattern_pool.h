@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "../common/const.h"
+#include "../common/pattern.h"
+
+namespace sequencer {
+
+    // Statically sized pool of patterns.
+    //
+    // All slots are stored inline and handed out from a free list, so adding a pattern never
+    // allocates and slot indices stay stable. Slots are replaced in place, never given back.
+    class PatternPool {
+    public:
+        static constexpr uint8_t CAPACITY = MAX_PATTERNS;
+        static constexpr uint8_t INVALID_INDEX = 0xFF;
+
+        PatternPool();
+
+        /**
+         * @brief Copy a pattern into a free slot
+         *
+         * @return The slot index, or INVALID_INDEX if all slots are in use
+         */
+        uint8_t allocate(const common::Pattern& pattern);
+
+        /**
+         * @brief Copy a pattern into a specific free slot
+         *
+         * @return false if the slot is out of range or already in use
+         */
+        bool allocateAt(uint8_t index, const common::Pattern& pattern);
+
+        bool isUsed(size_t index) const { return index < CAPACITY && used[index]; }
+        uint8_t size() const { return CAPACITY - freeCount; }
+
+        common::Pattern& operator[](uint8_t index) { return slots[index]; }
+        const common::Pattern& operator[](uint8_t index) const { return slots[index]; }
+
+    private:
+        common::Pattern slots[CAPACITY];
+        bool used[CAPACITY];
+        uint8_t freeList[CAPACITY];
+        uint8_t freeCount;
+    };
+
+} // namespace sequencer
@@ -0,0 +1,92 @@
+#include "pattern_timeline.h"
+
+namespace sequencer {
+
+    PatternTimeline::PatternTimeline() :
+        events{},
+        eventCount(0),
+        length(0),
+        cursor(0),
+        tick(0),
+        firstCycle(true),
+        startsHigh(false),
+        startEvent{ 0, 1 } {
+    }
+
+    void PatternTimeline::compile(const common::GateSet& gateSet) {
+        const uint32_t* risingEdges = gateSet.getRisingEdges();
+        const uint32_t* fallingEdges = gateSet.getFallingEdges();
+
+        // Walking the set bits of the edge masks yields the events already sorted by tick
+        eventCount = 0;
+        for (uint8_t w = 0; w < common::GateSet::WORD_COUNT; w++) {
+            uint32_t edges = risingEdges[w] | fallingEdges[w];
+            while (edges) {
+                uint8_t bit = __builtin_ctz(edges);
+                edges &= edges - 1;
+
+                TimelineEvent& event = events[eventCount++];
+                event.tick = (w << 5) | bit;
+                event.noteOn = (risingEdges[w] >> bit) & 1u;
+            }
+        }
+
+        length = gateSet.getLength();
+        startsHigh = gateSet.getGateAt(0);
+        seek(tick);
+    }
+
+    void PatternTimeline::reset() {
+        tick = 0;
+        cursor = 0;
+        firstCycle = true;
+    }
+
+    const TimelineEvent* PatternTimeline::advance() {
+        if (length == 0) return nullptr;
+
+        const TimelineEvent* due = nullptr;
+        if (cursor < eventCount && events[cursor].tick == tick) {
+            due = &events[cursor];
+            cursor++;
+        }
+        if (firstCycle && tick == 0) {
+            due = startsHigh ? &startEvent : nullptr;
+        }
+
+        tick++;
+        if (tick >= length) {
+            tick = 0;
+            cursor = 0;
+            firstCycle = false;
+        }
+        return due;
+    }
+
+    uint16_t PatternTimeline::ticksUntilNextEvent() const {
+        uint16_t next = cursor;
+        if (firstCycle && tick == 0) {
+            if (startsHigh) return 0;
+            // An edge at tick 0 is skipped on the first cycle
+            if (next < eventCount && events[next].tick == 0) next++;
+        }
+        if (next < eventCount) return events[next].tick - tick;
+        if (eventCount == 0) return UINT16_MAX;
+        // Next event is in the following cycle
+        return (length - tick) + events[0].tick;
+    }
+
+    void PatternTimeline::seek(uint16_t tick) {
+        if (length > 0 && tick >= length) {
+            tick = 0;
+            firstCycle = false;
+        }
+        this->tick = tick;
+
+        cursor = 0;
+        while (cursor < eventCount && events[cursor].tick < tick) {
+            cursor++;
+        }
+    }
+
+} // namespace sequencer
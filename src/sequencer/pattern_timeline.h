@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstdint>
+#include "../common/gate_set.h"
+
+namespace sequencer {
+
+    // A gate edge of one pattern cycle
+    struct TimelineEvent {
+        uint16_t tick : 15;     // offset within the gate cycle
+        uint16_t noteOn : 1;    // 1 = note on (rising edge), 0 = note off (falling edge)
+    };
+
+    // Gate edges of a pattern compiled into a sorted event list.
+    //
+    // The list is rebuilt only when the gate set changes. Playback advances a cursor by one tick
+    // per call, so a tick costs a compare per pattern instead of walking the gate set. Pitch and
+    // velocity are picked from their sets when a note on fires, since they advance per note and
+    // do not repeat with the gate cycle.
+    class PatternTimeline {
+    public:
+        // A tick holds at most one edge, so a cycle never has more events than ticks
+        static constexpr uint16_t MAX_EVENTS = common::GateSet::MAX_LENGTH;
+
+        PatternTimeline();
+
+        /**
+         * @brief Rebuild the events from the gate set's edge masks
+         *
+         * The playback position is kept (wrapped to the new length), so a pattern can be
+         * recompiled while it plays.
+         */
+        void compile(const common::GateSet& gateSet);
+
+        // Rewind to the start of the first cycle
+        void reset();
+
+        /**
+         * @brief Advance playback by one tick
+         *
+         * @return The event due at the current tick, or nullptr
+         */
+        const TimelineEvent* advance();
+
+        // Ticks until the next event fires (0 if it fires on the next advance), lookahead for scheduling
+        uint16_t ticksUntilNextEvent() const;
+
+        uint16_t getTick() const { return tick; }
+        uint16_t getLength() const { return length; }
+        uint16_t getEventCount() const { return eventCount; }
+
+    private:
+        TimelineEvent events[MAX_EVENTS];
+        uint16_t eventCount;
+        uint16_t length;
+        uint16_t cursor;
+        uint16_t tick;
+        // The first tick after reset() starts the note if the first gate is high,
+        // regardless of the edge computed against the end of the cycle
+        bool firstCycle;
+        bool startsHigh;
+        TimelineEvent startEvent;
+
+        void seek(uint16_t tick);
+    };
+
+} // namespace sequencer
@@ -7,13 +7,17 @@
 #include "../common/gate_set.h"
 #include "../common/const.h"
 #include "../common/pattern.h"
-#include <cstdio>
+#include "../common/log.h"
+#include "../common/profiler.h"
 
 namespace sequencer {
 
     // Global variables for multicore communication
     static Sequencer* globalSequencer = nullptr;
 
+    PROFILE_ZONE(updateZone, "Sequencer::update");
+    PROFILE_ZONE(processCommandZone, "Sequencer::processCmd");
+
     // Multicore FIFO for command passing
     static void sequencer_task(uart_inst_t* uart);
 
@@ -22,9 +26,12 @@ namespace sequencer {
         uart(uart),
         bpm(120),
         playing(false),
-        lastTickTime(get_absolute_time()),
         midiClockEnabled(true),
-        patterns({ common::Pattern() }) {
+        pendingEdits{},
+        songTick(0) {
+        resetPatternNotes();
+        addPattern(common::Pattern());
+
         // Initialize UART for MIDI
         uart_init(uart, MIDI_BAUD_RATE);
 
@@ -34,48 +41,115 @@ namespace sequencer {
     }
 
     void Sequencer::init() {
-        // TODO: reset values to default
+        // Runs on core 1, so the tick alarm and UART TX IRQs are serviced by the sequencer core
+        common::initProfilerCore();
+        tickClock.init();
+        midiTxQueue.init(uart);
     }
 
     void Sequencer::update() {
-        if (!playing) return;
+        PROFILE_SCOPE(updateZone);
 
-        // Calculate time for one tick based on BPM
-        uint32_t tickDurationUs = 60 * 1000 * 1000 / (bpm * PPQN);
+        // Ticks are counted by the alarm IRQ, process every one that is due
+        while (tickClock.consumeTick()) {
+            // Patterns are only swapped between ticks, never while one is processed
+            applyPatternEdits();
+            tick();
+        }
+        if (!playing) {
+            applyPatternEdits();
+        }
+    }
+
+    void Sequencer::tick() {
+        songTick++;
+        commands::PatternMask noteOns = 0;
+        commands::PatternMask noteOffs = 0;
 
-        // Check if it's time for the next tick
-        absolute_time_t currentTime = get_absolute_time();
-        if (absolute_time_diff_us(lastTickTime, currentTime) >= tickDurationUs) {
-            lastTickTime = currentTime;
+        // Process all active patterns
+        for (uint8_t index = 0; index < PatternPool::CAPACITY; index++) {
+            if (!patterns.isUsed(index)) continue;
+            common::Pattern& pattern = patterns[index];
+            if (!pattern.isActive()) continue;
 
-            // Process all active patterns
-            for (auto& pattern : patterns) {
-                if (!pattern.isActive()) continue;
+            common::PitchSet& pitchSet = pattern.getPitchSet();
+            common::VelocitySet& velocitySet = pattern.getVelocitySet();
 
-                // Get non-const references to the pattern components
-                common::GateSet& gateSet = const_cast<common::GateSet&>(pattern.getGateSet());
-                common::PitchSet& pitchSet = const_cast<common::PitchSet&>(pattern.getPitchSet());
-                common::VelocitySet& velocitySet = const_cast<common::VelocitySet&>(pattern.getVelocitySet());
+            if (pitchSet.getLength() == 0 || velocitySet.getLength() == 0) continue;
 
-                if (pitchSet.getPitches().empty() || velocitySet.getVelocities().empty() || gateSet.getGates().empty()) continue;
+            // Only ticks with a gate edge produce an event
+            const TimelineEvent* event = timelines[index].advance();
+            if (!event) continue;
 
-                common::Flank flank = gateSet.getFlank();
+            PatternNote& heldNote = patternNotes[index];
 
-                if (flank == common::RISING) {
-                    sendMidiNoteOn(pattern.getMidiChannel(), pitchSet.getPitch(), velocitySet.getVelocity());
+            if (event->noteOn) {
+                // A pattern swapped in while its note sounded can rise again before the old gate
+                // fell, the old note must not be forgotten
+                if (heldNote.note != NO_NOTE) {
+                    sendMidiNoteOff(heldNote.channel, heldNote.note);
+                    noteOffs |= commands::PatternMask(1) << index;
                 }
-                else if (flank == common::FALLING) {
-                    sendMidiNoteOff(pattern.getMidiChannel(), pitchSet.getPitch());
-                    pitchSet.setPosition(pitchSet.getPosition() + 1);
-                    velocitySet.setPosition(velocitySet.getPosition() + 1);
+                heldNote.channel = pattern.getMidiChannel();
+                heldNote.note = pitchSet.getPitch();
+                sendMidiNoteOn(heldNote.channel, heldNote.note, velocitySet.getVelocity());
+                noteOns |= commands::PatternMask(1) << index;
+            }
+            else {
+                if (heldNote.note != NO_NOTE) {
+                    sendMidiNoteOff(heldNote.channel, heldNote.note);
+                    heldNote.note = NO_NOTE;
+                    noteOffs |= commands::PatternMask(1) << index;
                 }
-                int nextGatePosition = gateSet.getPosition() + 1;
-                gateSet.setPosition(nextGatePosition);
+                // Wrap here, setPosition() warns about positions past the end
+                uint8_t nextPitch = pitchSet.getPosition() + 1;
+                uint8_t nextVelocity = velocitySet.getPosition() + 1;
+                pitchSet.setPosition(nextPitch < pitchSet.getLength() ? nextPitch : 0);
+                velocitySet.setPosition(nextVelocity < velocitySet.getLength() ? nextVelocity : 0);
             }
         }
+
+        publishTelemetry(noteOns, noteOffs);
+    }
+
+    void Sequencer::publishTelemetry(commands::PatternMask noteOns, commands::PatternMask noteOffs) {
+        // Filled in place, the UI core reads the previous snapshot meanwhile
+        commands::Telemetry& telemetry = commands::beginTelemetry();
+        TickStats stats = tickClock.getStats();
+
+        telemetry.songTick = songTick;
+        telemetry.usedPatterns = 0;
+        telemetry.activePatterns = 0;
+        telemetry.noteOns = noteOns;
+        telemetry.noteOffs = noteOffs;
+        telemetry.lateUs = stats.lateLastUs > UINT16_MAX ? UINT16_MAX : stats.lateLastUs;
+        telemetry.lateMaxUs = stats.lateMaxUs > UINT16_MAX ? UINT16_MAX : stats.lateMaxUs;
+        telemetry.playing = playing;
+
+        for (uint8_t index = 0; index < MAX_PATTERNS; index++) {
+            commands::PatternTelemetry& patternTelemetry = telemetry.patterns[index];
+            patternTelemetry.tick = timelines[index].getTick();
+            patternTelemetry.length = timelines[index].getLength();
+            patternTelemetry.note = patternNotes[index].note;
+            if (!patterns.isUsed(index)) continue;
+            telemetry.usedPatterns |= commands::PatternMask(1) << index;
+            if (patterns[index].isActive()) telemetry.activePatterns |= commands::PatternMask(1) << index;
+        }
+
+        commands::publishTelemetry();
+    }
+
+    TickStats Sequencer::getTickStats() const {
+        return tickClock.getStats();
     }
 
-    void Sequencer::processCommand(commands::CommandMessage msg) {
+    MidiTxStats Sequencer::getMidiTxStats() const {
+        return midiTxQueue.getStats();
+    }
+
+    void Sequencer::processCommand(const commands::CommandMessage& msg) {
+        PROFILE_SCOPE(processCommandZone);
+
         switch (msg.cmd) {
         case commands::Command::PLAY:
             play();
@@ -95,6 +169,16 @@ namespace sequencer {
             // Add more command handlers as needed
         case commands::Command::PATTERN_EUCLIDEAN_SET_LENGTH:
             patternSetEuclideanLength(msg.param1, msg.param2);
+            break;
+        case commands::Command::MIDI_RUNNING_STATUS_SET:
+            setMidiRunningStatus(msg.param1 != 0);
+            break;
+        case commands::Command::PATTERN_PITCHES_SET:
+            patternSetPitches(msg.param1, msg.payload, msg.payloadLength);
+            break;
+        case commands::Command::PATTERN_VELOCITIES_SET:
+            patternSetVelocities(msg.param1, msg.payload, msg.payloadLength);
+            break;
         }
     }
 
@@ -104,75 +188,159 @@ namespace sequencer {
             sendMidiByte(midi::SystemRealTimeMessage::START);
         }
         
-        // Set playing state and initialize timing
+        // Set playing state and start the tick clock
         playing = true;
-        lastTickTime = get_absolute_time();
+        tickClock.start(bpm);
         
         // Clear pattern notes tracking to start fresh
-        patternNotes.clear();
+        resetPatternNotes();
+        songTick = 0;
     }
 
     void Sequencer::stop() {
         playing = false;
+        tickClock.stop();
 
         // Send note off only for active notes
-        for (uint8_t channel = 0; channel < 16; channel++) {
-            for (uint8_t note = 0; note < 128; note++) {
-                if (activeNotes[channel][note]) {
-                    sendMidiNoteOff(channel, note);
-                }
-            }
-        }
+        activeNotes.forEach([this](uint8_t channel, uint8_t note) {
+            sendMidiNoteOff(channel, note);
+        });
+        resetPatternNotes();
 
         // set all sets in all paterns to position 0
-        for (auto& pattern : patterns) {
+        for (uint8_t index = 0; index < PatternPool::CAPACITY; index++) {
+            if (!patterns.isUsed(index)) continue;
+            common::Pattern& pattern = patterns[index];
             pattern.getGateSet().reset();
             pattern.getPitchSet().reset();
             pattern.getVelocitySet().reset();
+            timelines[index].reset();
         }
+
+        // Let the UI see the stopped state and the rewound playheads
+        publishTelemetry(0, 0);
+
+        // Reported last through the deferred log, the UI core prints it
+        TickStats stats = tickClock.getStats();
+        LOG_INFO("Tick stats: ticks=%u lateLast=%uus lateMax=%uus lagMax=%uus\n",
+            stats.ticks, stats.lateLastUs, stats.lateMaxUs, stats.lagMaxUs);
+        LOG_INFO("Tick stats: missed=%u overruns=%u\n", stats.missed, stats.overruns);
+        MidiTxStats txStats = midiTxQueue.getStats();
+        LOG_INFO("MIDI TX stats: highWater=%u/%u overflows=%u\n",
+            txStats.highWater, static_cast<uint32_t>(MidiTxQueue::CAPACITY), txStats.overflows);
     }
 
     void Sequencer::setBPM(uint16_t bpm) {
         this->bpm = bpm;
+        tickClock.setBPM(bpm);
+    }
+
+    void Sequencer::setMidiRunningStatus(bool enabled) {
+        midiEncoder.setRunningStatus(enabled);
     }
 
     void Sequencer::addPattern(const common::Pattern& pattern) {
-        patterns.push_back(pattern);
+        // Copied into a fixed slot, never allocates
+        uint8_t index = patterns.allocate(pattern);
+        if (index == PatternPool::INVALID_INDEX) {
+            LOG_WARN("Sequencer::addPattern: all %d pattern slots are in use\n", MAX_PATTERNS);
+            return;
+        }
+        patternNotes[index].note = NO_NOTE;
+        timelines[index].reset();
+        rebuildTimeline(index);
+    }
+
+    void Sequencer::applyPatternEdits() {
+        bool atBar = !playing || songTick % TICKS_PER_BAR == 0;
+
+        for (uint8_t index = 0; index < MAX_PATTERNS; index++) {
+            const commands::PatternEdit* edit = commands::receivePattern(index);
+            if (edit) {
+                // A newer edit replaces one still waiting for its bar
+                pendingEdits[index] = edit;
+            }
+            edit = pendingEdits[index];
+            if (!edit) continue;
+            if (edit->apply == commands::PatternApply::NEXT_BAR && !atBar) continue;
+
+            replacePattern(index, edit->pattern);
+            pendingEdits[index] = nullptr;
+        }
+    }
+
+    void Sequencer::replacePattern(uint8_t index, const common::Pattern& pattern) {
+        if (!patterns.isUsed(index)) {
+            if (!patterns.allocateAt(index, pattern)) return;
+            patternNotes[index].note = NO_NOTE;
+            timelines[index].reset();
+            rebuildTimeline(index);
+            return;
+        }
+
+        // Keep playing from the same place, wrapped to the new lengths
+        common::Pattern& slot = patterns[index];
+        uint8_t pitchPosition = slot.getPitchSet().getPosition();
+        uint8_t velocityPosition = slot.getVelocitySet().getPosition();
+
+        slot = pattern;
+        common::PitchSet& pitchSet = slot.getPitchSet();
+        common::VelocitySet& velocitySet = slot.getVelocitySet();
+        pitchSet.reset();
+        velocitySet.reset();
+        if (pitchSet.getLength() > 0) pitchSet.setPosition(pitchPosition % pitchSet.getLength());
+        if (velocitySet.getLength() > 0) velocitySet.setPosition(velocityPosition % velocitySet.getLength());
+
+        // The held note keeps its recorded channel and pitch. It ends at the new pattern's next
+        // falling edge, or at its next rising edge if that comes first (see tick())
+        rebuildTimeline(index);
     }
 
     void Sequencer::activatePattern(size_t index) {
-        if (index < patterns.size()) {
+        if (patterns.isUsed(index)) {
             patterns[index].setActive(true);
         }
     }
 
     void Sequencer::deactivatePattern(size_t index) {
-        if (index < patterns.size()) {
+        if (patterns.isUsed(index)) {
             patterns[index].setActive(false);
         }
     }
 
     void Sequencer::patternSetEuclideanLength(size_t patternIndex, size_t length) {
-        printf("TODO: patternSetEuclideanLength: %d, %d\n", patternIndex, length);
+        LOG_INFO("TODO: patternSetEuclideanLength: %d, %d\n", patternIndex, length);
         // if (patternIndex < patterns.size()) {
         //     patterns[patternIndex].setEuclideanLength(length);
         // }
     }
 
+    void Sequencer::patternSetPitches(size_t index, const uint8_t* pitches, uint8_t count) {
+        if (patterns.isUsed(index)) {
+            patterns[index].getPitchSet().setPitches(pitches, count);
+        }
+    }
+
+    void Sequencer::patternSetVelocities(size_t index, const uint8_t* velocities, uint8_t count) {
+        if (patterns.isUsed(index)) {
+            patterns[index].getVelocitySet().setVelocities(velocities, count);
+        }
+    }
+
     void Sequencer::sendMidiNoteOn(uint8_t channel, uint8_t note, uint8_t velocity) {
         // Ensure channel and note are within valid ranges
         channel = channel & 0x0F;  // Limit to 0-15
         note = note & 0x7F;       // Limit to 0-127
         
         // Track this note as active
-        activeNotes[channel][note] = true;
+        activeNotes.set(channel, note);
         
         // MIDI Note On: status byte + channel, note, velocity
         // MIDI channels are 1-based in the API but 0-based in the protocol
         uint8_t channelIndex = (channel > 0) ? (channel - 1) : 0;
-        sendMidiByte(midi::ChannelVoiceMessage::NOTE_ON | (channelIndex & 0x0F));
-        sendMidiByte(note & 0x7F);
-        sendMidiByte(velocity & 0x7F);
+        uint8_t message[MidiEncoder::MAX_MESSAGE_LENGTH];
+        uint8_t length = midiEncoder.encodeNoteOn(channelIndex, note, velocity, message);
+        sendMidiMessage(message, length);
     }
 
     void Sequencer::sendMidiNoteOff(uint8_t channel, uint8_t note) {
@@ -181,28 +349,54 @@ namespace sequencer {
         note = note & 0x7F;       // Limit to 0-127
         
         // Mark this note as inactive
-        activeNotes[channel][note] = false;
+        activeNotes.clear(channel, note);
         
         // MIDI Note Off: status byte + channel, note, velocity (0)
+        // or Note On with velocity 0 while that status is running
         // MIDI channels are 1-based in the API but 0-based in the protocol
         uint8_t channelIndex = (channel > 0) ? (channel - 1) : 0;
-        sendMidiByte(midi::ChannelVoiceMessage::NOTE_OFF | (channelIndex & 0x0F));
-        sendMidiByte(note & 0x7F);
-        sendMidiByte(0); // velocity 0
+        uint8_t message[MidiEncoder::MAX_MESSAGE_LENGTH];
+        uint8_t length = midiEncoder.encodeNoteOff(channelIndex, note, message);
+        sendMidiMessage(message, length);
     }
 
     void Sequencer::sendMidiByte(uint8_t byte) {
-        uart_putc_raw(uart, byte);
+        if (byte >= midi::SystemCommonMessage::SYSEX_START) {
+            midiEncoder.onSystemMessage(byte);
+        }
+        sendMidiMessage(&byte, 1);
+    }
+
+    void Sequencer::sendMidiMessage(const uint8_t* data, uint8_t length) {
+        // Queued and sent by the UART TX interrupt, never waits for the wire
+        if (!midiTxQueue.push(data, length)) {
+            // A dropped message may have carried the status byte the receiver needs next
+            midiEncoder.reset();
+        }
+    }
+
+    void Sequencer::resetPatternNotes() {
+        for (auto& heldNote : patternNotes) {
+            heldNote.channel = 0;
+            heldNote.note = NO_NOTE;
+        }
+    }
+
+    void Sequencer::rebuildTimeline(size_t index) {
+        timelines[index].compile(patterns[index].getGateSet());
     }
 
     // Sequencer task for second core
     static void sequencer_task() {
         // Make sure the global sequencer is initialized
         if (globalSequencer) {
+            globalSequencer->init();
+
             while (true) {
-                // Check for commands from the UI core
-                commands::CommandMessage msg = commands::receiveCommand();
-                globalSequencer->processCommand(msg);
+                // Handle all commands queued by the UI core
+                commands::receiveCommands([](const commands::CommandMessage& msg, void* context) {
+                    static_cast<Sequencer*>(context)->processCommand(msg);
+                }, globalSequencer);
 
                 // Update the sequencer
                 globalSequencer->update();
@@ -214,7 +408,6 @@ namespace sequencer {
         // Create a global sequencer instance
         static Sequencer sequencer(uart, txPin, rxPin);
         globalSequencer = &sequencer;
-        globalSequencer->init();
 
         // Launch the sequencer task on the second core
         multicore_launch_core1(sequencer_task);
@@ -1,11 +1,18 @@
 #pragma once
 
-#include <vector>
 #include <cstdint>
-#include <map>
 #include "hardware/uart.h"
 #include "../commands/command.h"
+#include "../commands/pattern_exchange.h"
+#include "../commands/telemetry.h"
+#include "../common/const.h"
 #include "../common/pattern.h"
+#include "tick_clock.h"
+#include "midi_tx_queue.h"
+#include "midi_encoder.h"
+#include "note_bitset.h"
+#include "pattern_timeline.h"
+#include "pattern_pool.h"
 
 namespace sequencer {
 
@@ -19,36 +26,65 @@ namespace sequencer {
 
         void init();
         void update();
-        void processCommand(commands::CommandMessage msg);
+        void processCommand(const commands::CommandMessage& msg);
+
+        TickStats getTickStats() const;
+        MidiTxStats getMidiTxStats() const;
 
     private:
         uart_inst_t* uart;
-        std::vector<common::Pattern> patterns;
+        MidiTxQueue midiTxQueue;
+        MidiEncoder midiEncoder;
+        PatternPool patterns;
         uint16_t bpm;
         bool playing;
-        absolute_time_t lastTickTime;
+        TickClock tickClock;
         bool midiClockEnabled;
         
-        // Track active notes: activeNotes[channel][note] = true if the note is active
-        bool activeNotes[16][128] = {{false}};
-        
-        // Track which notes are active for each pattern and position
-        // patternNotes[patternIndex][position] = note number
-        std::map<size_t, std::map<uint32_t, uint8_t>> patternNotes;
+        // Track active notes: one bit per channel and note
+        NoteBitset activeNotes;
+
+        // Note currently held by each pattern, so its note off matches the note on
+        // even if the pattern's pitch set or channel changes in between
+        struct PatternNote {
+            uint8_t channel;
+            uint8_t note;
+        };
+        static constexpr uint8_t NO_NOTE = commands::Telemetry::NO_NOTE;
+        PatternNote patternNotes[MAX_PATTERNS];
+
+        // Gate edges of each pattern, recompiled whenever its gate set is replaced
+        PatternTimeline timelines[MAX_PATTERNS];
+
+        // Patterns published by the UI core that wait for their bar boundary
+        const commands::PatternEdit* pendingEdits[MAX_PATTERNS];
+        static constexpr uint32_t TICKS_PER_BAR = PPQN * 4;
+        uint32_t songTick;
+
+        void resetPatternNotes();
+        void rebuildTimeline(size_t index);
+        void applyPatternEdits();
+        void replacePattern(uint8_t index, const common::Pattern& pattern);
+        void publishTelemetry(commands::PatternMask noteOns, commands::PatternMask noteOffs);
 
+        void tick();
         void play();
         void stop();
         void setBPM(uint16_t bpm);
+        void setMidiRunningStatus(bool enabled);
         void sendMidiClock();
 
         void addPattern(const common::Pattern& pattern);
         void activatePattern(size_t index);
         void deactivatePattern(size_t index);
         void patternSetEuclideanLength(size_t patternIndex, size_t length);
+        void patternSetPitches(size_t index, const uint8_t* pitches, uint8_t count);
+        void patternSetVelocities(size_t index, const uint8_t* velocities, uint8_t count);
 
         void sendMidiNoteOn(uint8_t channel, uint8_t note, uint8_t velocity);
         void sendMidiNoteOff(uint8_t channel, uint8_t note);
         void sendMidiByte(uint8_t byte);
+        void sendMidiMessage(const uint8_t* data, uint8_t length);
 
     };
 
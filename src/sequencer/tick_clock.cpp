@@ -0,0 +1,145 @@
+#include "tick_clock.h"
+#include "hardware/timer.h"
+#include "hardware/sync.h"
+#include "../common/const.h"
+
+namespace sequencer {
+
+    static constexpr uint32_t MICROSECONDS_PER_MINUTE = 60 * 1000 * 1000;
+
+    // The hardware alarm callback carries no user data, so the owning clock is kept here
+    static TickClock* activeClock = nullptr;
+
+    TickClock::TickClock() :
+        alarmNum(-1),
+        running(false),
+        nextDeadlineUs(0),
+        lastDeadlineUs(0),
+        periodUs(0),
+        periodRemainder(0),
+        periodDivisor(1),
+        remainderAccumulator(0),
+        firedTicks(0),
+        consumedTicks(0),
+        stats{} {
+        setPeriod(120);
+    }
+
+    void TickClock::init() {
+        alarmNum = hardware_alarm_claim_unused(true);
+        activeClock = this;
+        hardware_alarm_set_callback(alarmNum, alarmCallback);
+    }
+
+    void TickClock::start(uint16_t bpm) {
+        stop();
+        setPeriod(bpm);
+
+        firedTicks = 0;
+        consumedTicks = 0;
+        remainderAccumulator = 0;
+        resetStats();
+
+        // First tick is due one period after start
+        nextDeadlineUs = time_us_64();
+        lastDeadlineUs = nextDeadlineUs;
+        advanceDeadline();
+
+        running = true;
+        armAlarm();
+    }
+
+    void TickClock::stop() {
+        running = false;
+        if (alarmNum >= 0) {
+            hardware_alarm_cancel(alarmNum);
+        }
+    }
+
+    void TickClock::setBPM(uint16_t bpm) {
+        // The alarm IRQ reads the period while advancing the deadline
+        uint32_t irqState = save_and_disable_interrupts();
+        setPeriod(bpm);
+        restore_interrupts(irqState);
+    }
+
+    bool TickClock::consumeTick() {
+        if (consumedTicks == firedTicks) return false;
+
+        uint32_t irqState = save_and_disable_interrupts();
+        // Lag is only meaningful while exactly one tick is pending, backlogs are counted as overruns
+        if (firedTicks - consumedTicks == 1) {
+            uint32_t lagUs = static_cast<uint32_t>(time_us_64() - lastDeadlineUs);
+            if (lagUs > stats.lagMaxUs) stats.lagMaxUs = lagUs;
+        }
+        restore_interrupts(irqState);
+
+        consumedTicks++;
+        return true;
+    }
+
+    TickStats TickClock::getStats() const {
+        uint32_t irqState = save_and_disable_interrupts();
+        TickStats copy = stats;
+        restore_interrupts(irqState);
+        return copy;
+    }
+
+    void TickClock::resetStats() {
+        uint32_t irqState = save_and_disable_interrupts();
+        stats = {};
+        restore_interrupts(irqState);
+    }
+
+    void TickClock::setPeriod(uint16_t bpm) {
+        if (bpm == 0) bpm = 1;
+        periodDivisor = static_cast<uint32_t>(bpm) * PPQN;
+        periodUs = MICROSECONDS_PER_MINUTE / periodDivisor;
+        periodRemainder = MICROSECONDS_PER_MINUTE % periodDivisor;
+        if (remainderAccumulator >= periodDivisor) remainderAccumulator = 0;
+    }
+
+    void TickClock::advanceDeadline() {
+        // Carry the fractional microseconds so the average period is exact
+        nextDeadlineUs += periodUs;
+        remainderAccumulator += periodRemainder;
+        if (remainderAccumulator >= periodDivisor) {
+            remainderAccumulator -= periodDivisor;
+            nextDeadlineUs++;
+        }
+    }
+
+    void TickClock::fireTick(uint64_t nowUs) {
+        uint32_t lateUs = static_cast<uint32_t>(nowUs - nextDeadlineUs);
+        stats.lateLastUs = lateUs;
+        if (lateUs > stats.lateMaxUs) stats.lateMaxUs = lateUs;
+        if (firedTicks != consumedTicks) stats.overruns++;
+        stats.ticks++;
+
+        lastDeadlineUs = nextDeadlineUs;
+        firedTicks = firedTicks + 1;
+        advanceDeadline();
+    }
+
+    void TickClock::armAlarm() {
+        // hardware_alarm_set_target returns true if the deadline has already passed,
+        // in that case the tick is fired right away and the grid is kept
+        while (hardware_alarm_set_target(alarmNum, from_us_since_boot(nextDeadlineUs))) {
+            stats.missed++;
+            fireTick(time_us_64());
+        }
+    }
+
+    void TickClock::onAlarm() {
+        if (!running) return;
+        fireTick(time_us_64());
+        armAlarm();
+    }
+
+    void TickClock::alarmCallback(uint alarmNum) {
+        if (activeClock && activeClock->alarmNum == static_cast<int>(alarmNum)) {
+            activeClock->onAlarm();
+        }
+    }
+
+} // namespace sequencer
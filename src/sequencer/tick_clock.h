@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstdint>
+#include "pico/types.h"
+
+namespace sequencer {
+
+    // Timing statistics of the tick clock (all times in microseconds)
+    struct TickStats {
+        uint32_t ticks;         // ticks fired by the alarm since start()
+        uint32_t lateLastUs;    // how late the alarm IRQ ran for the most recent tick
+        uint32_t lateMaxUs;     // worst alarm IRQ lateness since start()
+        uint32_t lagMaxUs;      // worst delay between a tick deadline and the loop consuming it
+        uint32_t missed;        // deadlines that had already passed when the alarm was armed
+        uint32_t overruns;      // ticks still pending when the next one fired (loop fell a whole tick behind)
+    };
+
+    // Hardware alarm driven tick source.
+    //
+    // The alarm IRQ only advances a phase accumulator (next deadline = previous deadline + period)
+    // and counts fired ticks, so late processing never shifts the tempo grid. The sequencer loop
+    // consumes the pending ticks with consumeTick().
+    class TickClock {
+    public:
+        TickClock();
+
+        /**
+         * @brief Claim a hardware alarm for the tick clock
+         *
+         * The alarm IRQ is enabled on the calling core, so this has to run on the
+         * core that consumes the ticks.
+         */
+        void init();
+
+        void start(uint16_t bpm);
+        void stop();
+        void setBPM(uint16_t bpm);
+
+        /**
+         * @brief Consume one pending tick
+         *
+         * @return true if a tick was pending and has to be processed now
+         */
+        bool consumeTick();
+
+        TickStats getStats() const;
+        void resetStats();
+
+    private:
+        int alarmNum;
+        volatile bool running;
+
+        // Phase accumulator: the period is periodUs + periodRemainder / periodDivisor
+        uint64_t nextDeadlineUs;
+        uint64_t lastDeadlineUs;
+        uint32_t periodUs;
+        uint32_t periodRemainder;
+        uint32_t periodDivisor;
+        uint32_t remainderAccumulator;
+
+        // firedTicks is only written by the alarm IRQ, consumedTicks only by the loop
+        volatile uint32_t firedTicks;
+        uint32_t consumedTicks;
+
+        // Written by the alarm IRQ, copied with interrupts disabled in getStats()
+        TickStats stats;
+
+        void setPeriod(uint16_t bpm);
+        void advanceDeadline();
+        void fireTick(uint64_t nowUs);
+        void armAlarm();
+        void onAlarm();
+
+        static void alarmCallback(uint alarmNum);
+    };
+
+} // namespace sequencer
@@ -1,17 +1,23 @@
 #include "UIController.h"
 #include "state/StateManager.h"
+#include "../commands/telemetry.h"
+#include "../common/profiler.h"
+#include "hardware/timer.h"
 #include <cstdio>
 
 namespace ui {
 
 UIController::UIController(const HardwareConfig& config)
-    : config(config), activeView(nullptr) {}
+    : config(config), activeView(nullptr), profileChordHeld(false) {}
+
+PROFILE_ZONE(updateZone, "UIController::update");
 
 UIController::~UIController() = default;
 
 void UIController::initialize()
 {
     printf("Initializing UI Controller...\n");
+    common::initProfilerCore();
 
     // Create hardware
     for (int i = 0; i < BUTTON_COUNT; i++) {
@@ -21,9 +27,12 @@ void UIController::initialize()
     pot = std::make_unique<hardware::Potentiometer>(config.potPin, PotId::POT_A);
     led = std::make_unique<hardware::Led>(config.ledPin);
     ledMatrix = std::make_unique<hardware::LedMatrix>(config.ledMatrixPin);
+    ledCompositor = std::make_unique<hardware::LedCompositor>(*ledMatrix);
+    display = std::make_unique<hardware::Display>(
+        config.lcdI2c, config.lcdAddress, config.lcdSdaPin, config.lcdSclPin);
 
     // Create views (allocated once at initialization)
-    initView = std::make_unique<InitView>(*led, *ledMatrix);
+    initView = std::make_unique<InitView>(*led, *ledMatrix, *ledCompositor, *display);
     settingsView = std::make_unique<SettingsView>(*led, *ledMatrix);
 
     // Initialize view array
@@ -34,14 +43,17 @@ void UIController::initialize()
     const state::UIState& initialState = state::getStateManager().getState();
     onStateChanged(initialState);
 
-    // Subscribe to state changes for view switching
-    state::getStateManager().subscribe([this](const state::UIState& newState) {
-        onStateChanged(newState);
-    });
+    // Subscribe to state changes for view switching, the views render every field
+    state::getStateManager().subscribe(&UIController::stateChanged, this, state::FIELD_ALL);
 
     printf("UI Controller initialized\n");
 }
 
+void UIController::stateChanged(const state::UIState& newState, state::StateFieldMask /*changed*/, void* context)
+{
+    static_cast<UIController*>(context)->onStateChanged(newState);
+}
+
 void UIController::onStateChanged(const state::UIState& newState)
 {
     IView* newView = views[static_cast<size_t>(newState.currentView)];
@@ -59,12 +71,33 @@ void UIController::onStateChanged(const state::UIState& newState)
 
 void UIController::update()
 {
+    PROFILE_SCOPE(updateZone);
+
     for (auto& button : buttons) {
         button->update();
     }
+
+    bool profileChord = buttons[static_cast<int>(ButtonId::BUTTON_A)]->isPressed() &&
+        buttons[static_cast<int>(ButtonId::BUTTON_F)]->isPressed();
+    if (profileChord && !profileChordHeld) {
+        common::dumpProfileZones();
+    }
+    profileChordHeld = profileChord;
     pot->update();
+
+    // The scans above only queue their events, the views render once for all of them
+    state::getStateManager().processEvents();
+
+    // Newest sequencer snapshot, older ones are skipped if the UI fell behind
+    const commands::Telemetry* telemetry = commands::receiveTelemetry();
+    if (telemetry != nullptr && activeView != nullptr) {
+        activeView->onTelemetry(*telemetry);
+    }
+
     led->update();
+    ledCompositor->update(time_us_32());
     ledMatrix->update();
+    display->update();
 }
 
 } // namespace ui
@@ -7,6 +7,8 @@
 #include "hardware/Potentiometer.h"
 #include "hardware/Led.h"
 #include "hardware/LedMatrix.h"
+#include "hardware/LedCompositor.h"
+#include "hardware/Display.h"
 #include "views/IView.h"
 #include "views/InitView.h"
 #include "views/SettingsView.h"
@@ -30,6 +32,8 @@ private:
     std::unique_ptr<hardware::Potentiometer> pot;
     std::unique_ptr<hardware::Led> led;
     std::unique_ptr<hardware::LedMatrix> ledMatrix;
+    std::unique_ptr<hardware::LedCompositor> ledCompositor;
+    std::unique_ptr<hardware::Display> display;
 
     // Views (heap-allocated but fixed at initialization, no dynamic allocation after)
     std::unique_ptr<InitView> initView;
@@ -37,6 +41,10 @@ private:
     std::array<IView*, static_cast<size_t>(state::ViewId::SETTINGS) + 1> views;
     IView* activeView;
 
+    // Buttons A and F together dump the profiling zones
+    bool profileChordHeld;
+
+    static void stateChanged(const state::UIState& newState, state::StateFieldMask changed, void* context);
     void onStateChanged(const state::UIState& newState);
 };
 
@@ -42,12 +42,12 @@ void Button::update()
                 pressStartTime = currentTime;
                 holdTriggered = false;
                 ui::events::Event event = ui::events::Event::buttonPressed(buttonId);
-                ui::state::getStateManager().dispatch(event);
+                ui::state::getStateManager().post(event);
             }
             else
             {
                 ui::events::Event event = ui::events::Event::buttonReleased(buttonId);
-                ui::state::getStateManager().dispatch(event);
+                ui::state::getStateManager().post(event);
             }
         }
 
@@ -55,7 +55,7 @@ void Button::update()
         {
             holdTriggered = true;
             ui::events::Event event = ui::events::Event::buttonHeld(buttonId);
-            ui::state::getStateManager().dispatch(event);
+            ui::state::getStateManager().post(event);
         }
     }
 
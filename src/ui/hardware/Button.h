@@ -11,6 +11,8 @@ public:
 
     void update();
 
+    bool isPressed() const { return pressed; }
+
 private:
     uint8_t pin;
     ui::ButtonId buttonId;
@@ -1,11 +1,23 @@
 #include "Display.h"
 #include "hardware/i2c.h"
 #include <cstdio>
-#include <string>
+#include <cstring>
 #include "driver/LCD_I2C.hpp"
 
 namespace hardware {
 
+// Shown in place of glyphs that found no free slot, more than 8 glyphs are on screen
+static constexpr char MISSING_GLYPH = '?';
+
+// A glyph without a slot counts as shown once its cell has the placeholder, so the placeholder
+// is not resent every update but the glyph is drawn as soon as a slot frees up
+static bool isShown(char wanted, char shown, const uint8_t* slots)
+{
+    if (wanted == shown) return true;
+    uint8_t code = static_cast<uint8_t>(wanted);
+    return code < LCD_GLYPH_COUNT && slots[code] == LcdCharCache::NO_SLOT && shown == MISSING_GLYPH;
+}
+
 Display::Display(i2c_inst_t* i2c, uint8_t i2cAddr, uint8_t sdaPin, uint8_t sclPin)
 {
     // Set up I2C pins and initialize
@@ -24,44 +36,168 @@ void Display::init()
     lcd->noCursor();
     lcd->noBlink();
 
-    // Clear the display
+    // Clear the display, the only full clear, later screens are diffed against it
     lcd->clear();
+    memset(shown, ' ', sizeof(shown));
+    lcdLine = 0;
+    lcdPosition = 0;
 
     // Turn on backlight
     lcd->backlight();
 
     // Write initial text
-    lcd->writeString("GenSeq");
-    lcd->writeChar(0b11111111);
+    clear();
+    print("GenSeq\xFF");
 }
 
 void Display::update()
 {
-    // Display doesn't need periodic updates in this implementation
+    commit();
+    // Writes only queue I2C transactions, this sends them
+    lcd->service();
+}
+
+void Display::flush(void (*callback)(void* context), void* context)
+{
+    // Writes so far only reached the shadow buffer, queue them before the callback
+    commit();
+    lcd->flush(callback, context);
+}
+
+bool Display::isIdle() const
+{
+    return lcd->isIdle();
 }
 
 
 void Display::clear()
 {
-    lcd->clear();
+    memset(shadow, ' ', sizeof(shadow));
+    line = 0;
+    position = 0;
 }
 
 void Display::setCursor(uint8_t line, uint8_t position)
 {
-    // Note: LCD_I2C uses different parameter order (position, line)
-    lcd->setCursor(position, line, false);
+    this->line = line < LINES ? line : LINES - 1;
+    this->position = position < COLUMNS ? position : COLUMNS - 1;
 }
 
 void Display::print(const char* text)
 {
-    lcd->writeString(text);
+    while (*text != '\0') {
+        put(*text++);
+    }
 }
 
 void Display::showSetting(const char* label, uint8_t* value)
 {
-    lcd->clear();
-    std::string text = std::string(label) + ": " + std::to_string(*value);
-    lcd->writeString(text.c_str());
+    char text[COLUMNS + 1];
+    snprintf(text, sizeof(text), "%s: %u", label, (unsigned)*value);
+    clear();
+    print(text);
+}
+
+void Display::printGlyph(LcdGlyph glyph)
+{
+    put(static_cast<char>(glyph));
+}
+
+void Display::drawBar(uint8_t line, uint8_t position, uint8_t width, uint16_t value, uint16_t max)
+{
+    uint32_t steps = static_cast<uint32_t>(width) * LCD_BAR_STEPS;
+    uint32_t filled = max > 0 ? (value < max ? value : max) * steps / max : 0;
+
+    setCursor(line, position);
+    for (uint8_t cell = 0; cell < width; cell++) {
+        uint32_t start = static_cast<uint32_t>(cell) * LCD_BAR_STEPS;
+        if (filled >= start + LCD_BAR_STEPS) put(static_cast<char>(LCD_FULL_BLOCK));
+        else if (filled > start) put(static_cast<char>(LCD_GLYPH_BAR_1 + (filled - start) - 1));
+        else put(' ');
+    }
+}
+
+void Display::pinGlyph(LcdGlyph glyph, bool pinned)
+{
+    charCache.pin(glyph, pinned);
+}
+
+void Display::put(char code)
+{
+    // Text past the end of the line is cut off
+    if (position < COLUMNS) shadow[line][position++] = code;
+}
+
+void Display::commit()
+{
+    if (memcmp(shadow, shown, sizeof(shadow)) == 0) return;
+
+    // Glyphs on screen and pinned ones need a slot, and only glyphs outside that set are evicted
+    uint16_t neededMask = charCache.getPinnedMask();
+    for (uint8_t y = 0; y < LINES; y++) {
+        for (uint8_t x = 0; x < COLUMNS; x++) {
+            uint8_t code = static_cast<uint8_t>(shadow[y][x]);
+            if (code < LCD_GLYPH_COUNT) neededMask |= 1u << code;
+        }
+    }
+
+    bool changed = false;
+    uint8_t slots[LCD_GLYPH_COUNT];
+    for (uint8_t glyph = 0; glyph < LCD_GLYPH_COUNT; glyph++) {
+        if (!(neededMask & (1u << glyph))) continue;
+        bool upload;
+        slots[glyph] = charCache.acquire(glyph, neededMask, upload);
+        if (upload) {
+            // Cells still showing the evicted glyph differ from the shadow and are redrawn below
+            lcd->createChar(slots[glyph], LCD_GLYPHS[glyph], true);
+            lcdLine = 0;
+            lcdPosition = 0;
+            changed = true;
+        }
+    }
+
+    for (uint8_t y = 0; y < LINES; y++) {
+        uint8_t x = 0;
+        while (x < COLUMNS) {
+            if (isShown(shadow[y][x], shown[y][x], slots)) {
+                x++;
+                continue;
+            }
+
+            // Resending one unchanged character is cheaper than a cursor move, so runs bridge
+            // single character gaps
+            uint8_t end = x + 1;
+            while (end < COLUMNS) {
+                if (!isShown(shadow[y][end], shown[y][end], slots)) end++;
+                else if (end + 1 < COLUMNS && !isShown(shadow[y][end + 1], shown[y][end + 1], slots)) end += 2;
+                else break;
+            }
+
+            if (y != lcdLine || x != lcdPosition) {
+                lcd->setCursor(y, x, true);
+            }
+            for (; x < end; x++) {
+                uint8_t code = static_cast<uint8_t>(shadow[y][x]);
+                char cell = shadow[y][x];
+                if (code < LCD_GLYPH_COUNT) {
+                    if (slots[code] != LcdCharCache::NO_SLOT) {
+                        code = slots[code];
+                    }
+                    else {
+                        code = MISSING_GLYPH;
+                        cell = MISSING_GLYPH;
+                    }
+                }
+                lcd->writeChar(code, true);
+                shown[y][x] = cell;
+            }
+            // After the last column the LCD continues on another line, COLUMNS never matches
+            lcdLine = y;
+            lcdPosition = x;
+            changed = true;
+        }
+    }
+    if (changed) lcd->show();
 }
 
 } // namespace hardware
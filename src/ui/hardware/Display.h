@@ -1,6 +1,8 @@
 #pragma once
 
 #include <cstdint>
+#include "LcdCharCache.h"
+#include "driver/lcd_glyphs.h"
 
 struct i2c_inst;
 typedef struct i2c_inst i2c_inst_t;
@@ -8,21 +10,51 @@ class LCD_I2C;
 
 namespace hardware {
 
+// 20x4 character LCD behind a shadow buffer.
+//
+// clear(), setCursor(), print() and showSetting() only change the shadow buffer. update() compares
+// it with what the LCD shows and sends just the changed runs of each line, so redrawing a screen
+// where one value changed costs a cursor move and a few characters instead of a full rewrite.
+// Custom glyphs are kept in the shadow buffer by id and uploaded to a CGRAM slot only when the
+// slot does not hold them yet. At most 8 different glyphs can be on screen at once.
 class Display {
 public:
+    static constexpr uint8_t COLUMNS = 20;
+    static constexpr uint8_t LINES = 4;
+
     Display(i2c_inst_t* i2c, uint8_t i2cAddr, uint8_t sdaPin, uint8_t sclPin);
 
+    // Call from the UI loop, sends the changes to the LCD without blocking
     void update();
+    // Get called back from update() once everything written so far is on the LCD
+    void flush(void (*callback)(void* context), void* context);
+    bool isIdle() const;
 
     void clear();
     void setCursor(uint8_t line, uint8_t position);
     void print(const char* text);
     void showSetting(const char* label, uint8_t* value);
 
+    // Write a custom glyph at the cursor
+    void printGlyph(LcdGlyph glyph);
+    // Horizontal bar graph over width cells, filled in fifths of a cell
+    void drawBar(uint8_t line, uint8_t position, uint8_t width, uint16_t value, uint16_t max);
+    // Keep a glyph uploaded even while it is not on screen, e.g. the playhead of a running sequence
+    void pinGlyph(LcdGlyph glyph, bool pinned = true);
+
 private:
     void init();
+    void commit();
+    void put(char code);
 
     LCD_I2C* lcd;
+    LcdCharCache charCache;
+    char shadow[LINES][COLUMNS];    // what the views want to show, glyph ids below LCD_GLYPH_COUNT
+    char shown[LINES][COLUMNS];     // what the LCD shows
+    uint8_t line;                   // write position in the shadow buffer
+    uint8_t position;
+    uint8_t lcdLine;                // LCD cursor, lcdPosition is COLUMNS if unknown
+    uint8_t lcdPosition;
 };
 
 } // namespace hardware
@@ -2,6 +2,9 @@
 
 #include <cstdint>
 
+struct i2c_inst;
+typedef struct i2c_inst i2c_inst_t;
+
 namespace ui {
 
 // Hardware configuration structure
@@ -17,6 +20,12 @@ struct HardwareConfig {
 
     // Potentiometer pin (ADC)
     uint8_t potPin;
+
+    // LCD I2C bus, address and pins
+    i2c_inst_t* lcdI2c;
+    uint8_t lcdAddress;
+    uint8_t lcdSdaPin;
+    uint8_t lcdSclPin;
 };
 
 } // namespace ui
@@ -0,0 +1,57 @@
+#include "LcdCharCache.h"
+
+namespace hardware {
+
+LcdCharCache::LcdCharCache() :
+    useClock(0),
+    pinnedMask(0)
+{
+    invalidate();
+}
+
+uint8_t LcdCharCache::acquire(uint8_t glyph, uint16_t keepMask, bool& upload)
+{
+    upload = false;
+    useClock++;
+
+    uint8_t victim = NO_SLOT;
+    for (uint8_t slot = 0; slot < SLOTS; slot++) {
+        if (glyphs[slot] == glyph) {
+            lastUsed[slot] = useClock;
+            return slot;
+        }
+
+        // Empty slots first, then the least recently used glyph nobody needs
+        if (glyphs[slot] == NO_GLYPH) {
+            if (victim == NO_SLOT || glyphs[victim] != NO_GLYPH) victim = slot;
+            continue;
+        }
+        uint16_t bit = 1u << glyphs[slot];
+        if ((pinnedMask | keepMask) & bit) continue;
+        if (victim == NO_SLOT || (glyphs[victim] != NO_GLYPH && lastUsed[slot] < lastUsed[victim])) {
+            victim = slot;
+        }
+    }
+
+    if (victim == NO_SLOT) return NO_SLOT;
+    glyphs[victim] = glyph;
+    lastUsed[victim] = useClock;
+    upload = true;
+    return victim;
+}
+
+void LcdCharCache::pin(uint8_t glyph, bool pinned)
+{
+    if (pinned) pinnedMask |= 1u << glyph;
+    else pinnedMask &= ~(1u << glyph);
+}
+
+void LcdCharCache::invalidate()
+{
+    for (uint8_t slot = 0; slot < SLOTS; slot++) {
+        glyphs[slot] = NO_GLYPH;
+        lastUsed[slot] = 0;
+    }
+}
+
+} // namespace hardware
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstdint>
+
+namespace hardware {
+
+// Tracks which glyphs sit in the 8 CGRAM slots of the LCD.
+//
+// Bookkeeping only, the caller uploads a glyph when acquire() asks for it. When all slots are
+// taken the least recently used one is reused, skipping pinned glyphs and the glyphs the caller
+// still shows.
+class LcdCharCache {
+public:
+    static constexpr uint8_t SLOTS = 8;
+    static constexpr uint8_t NO_SLOT = 0xFF;
+    static constexpr uint8_t NO_GLYPH = 0xFF;
+
+    LcdCharCache();
+
+    /**
+     * @brief Find or make a slot for a glyph and mark it as used
+     *
+     * @param glyph Glyph id, below 16
+     * @param keepMask Bit per glyph id that must not be evicted, usually the glyphs on screen
+     * @param upload Set to true if the glyph is not in the slot yet and must be uploaded
+     * @return Slot, NO_SLOT if every slot holds a pinned or kept glyph
+     */
+    uint8_t acquire(uint8_t glyph, uint16_t keepMask, bool& upload);
+
+    // Pinned glyphs are never evicted, pinning more than SLOTS glyphs starves the others
+    void pin(uint8_t glyph, bool pinned);
+    uint16_t getPinnedMask() const { return pinnedMask; }
+
+    // Forget all slots, e.g. after the LCD was reset
+    void invalidate();
+
+private:
+    uint8_t glyphs[SLOTS];      // glyph id per slot or NO_GLYPH
+    uint32_t lastUsed[SLOTS];   // useClock at the last acquire
+    uint32_t useClock;
+    uint16_t pinnedMask;
+};
+
+} // namespace hardware
@@ -0,0 +1,274 @@
+#include "LedCompositor.h"
+#include "driver/led_matrix_pattern.h"
+#include <cstring>
+
+namespace hardware {
+
+static uint8_t lerpChannel(uint32_t from, uint32_t to, uint8_t shift, uint32_t position, uint32_t span)
+{
+    int32_t a = (from >> shift) & 0xFF;
+    int32_t b = (to >> shift) & 0xFF;
+    return static_cast<uint8_t>(a + (b - a) * static_cast<int32_t>(position) / static_cast<int32_t>(span));
+}
+
+LedCompositor::LedCompositor(LedMatrix& matrix) :
+    matrix(matrix),
+    layers{},
+    animations{},
+    scrollers{},
+    lastStepUs(0),
+    started(false)
+{
+    matrix.setOverlay(this);
+}
+
+LedCompositor::~LedCompositor()
+{
+    matrix.setOverlay(nullptr);
+}
+
+void LedCompositor::update(uint32_t nowUs)
+{
+    if (!started) {
+        lastStepUs = nowUs;
+        started = true;
+        return;
+    }
+
+    uint32_t due = (nowUs - lastStepUs) / STEP_US;
+    if (due == 0) return;
+    if (due > MAX_CATCH_UP_STEPS) {
+        due = MAX_CATCH_UP_STEPS;
+        lastStepUs = nowUs;
+    }
+    else {
+        lastStepUs += due * STEP_US;
+    }
+
+    for (uint32_t i = 0; i < due; i++) {
+        step();
+    }
+}
+
+void LedCompositor::clearLayer(uint8_t layer)
+{
+    if (layer >= MAX_LAYERS) return;
+    memset(layers[layer].mask, 0, sizeof(layers[layer].mask));
+    invalidateRows(0, LedMatrix::HEIGHT);
+}
+
+void LedCompositor::setPixel(uint8_t layer, uint8_t x, uint8_t y, uint32_t color)
+{
+    fillRect(layer, x, y, 1, 1, color);
+}
+
+void LedCompositor::clearPixel(uint8_t layer, uint8_t x, uint8_t y)
+{
+    clearRect(layer, x, y, 1, 1);
+}
+
+void LedCompositor::fillRect(uint8_t layer, int8_t x, int8_t y, uint8_t width, uint8_t height, uint32_t color)
+{
+    if (layer >= MAX_LAYERS) return;
+    Layer& target = layers[layer];
+    for (int16_t py = y; py < y + height; py++) {
+        if (py < 0 || py >= LedMatrix::HEIGHT) continue;
+        for (int16_t px = x; px < x + width; px++) {
+            if (px < 0 || px >= LedMatrix::WIDTH) continue;
+            target.colors[py * LedMatrix::WIDTH + px] = color;
+            target.mask[py] |= 1u << px;
+        }
+    }
+    invalidateRows(y, height);
+}
+
+void LedCompositor::clearRect(uint8_t layer, int8_t x, int8_t y, uint8_t width, uint8_t height)
+{
+    if (layer >= MAX_LAYERS) return;
+    Layer& target = layers[layer];
+    for (int16_t py = y; py < y + height; py++) {
+        if (py < 0 || py >= LedMatrix::HEIGHT) continue;
+        for (int16_t px = x; px < x + width; px++) {
+            if (px < 0 || px >= LedMatrix::WIDTH) continue;
+            target.mask[py] &= ~(1u << px);
+        }
+    }
+    invalidateRows(y, height);
+}
+
+uint8_t LedCompositor::animate(uint8_t layer, uint8_t width, uint8_t height, const Keyframe* keyframes, uint8_t count, bool loop)
+{
+    if (layer >= MAX_LAYERS || count == 0 || count > MAX_KEYFRAMES) return INVALID_ID;
+
+    for (uint8_t slot = 0; slot < MAX_ANIMATIONS; slot++) {
+        Animation& animation = animations[slot];
+        if (animation.active) continue;
+
+        for (uint8_t i = 0; i < count; i++) {
+            animation.keyframes[i] = keyframes[i];
+        }
+        animation.count = count;
+        animation.step = 0;
+        animation.layer = layer;
+        animation.width = width;
+        animation.height = height;
+        animation.loop = loop;
+        animation.drawn = false;
+        animation.active = true;
+        animation.generation = (animation.generation + 1) % ANIMATION_GENERATIONS;
+        // Show the first keyframe right away, not one step later
+        stepAnimation(animation);
+        return static_cast<uint8_t>(animation.generation << ANIMATION_SLOT_BITS | slot);
+    }
+    return INVALID_ID;
+}
+
+void LedCompositor::stopAnimation(uint8_t id)
+{
+    if (id == INVALID_ID) return;
+    Animation& animation = animations[id & (MAX_ANIMATIONS - 1)];
+    if (!animation.active || animation.generation != id >> ANIMATION_SLOT_BITS) return;
+    if (animation.drawn) {
+        clearRect(animation.layer, animation.drawnX, animation.drawnY, animation.width, animation.height);
+    }
+    animation.active = false;
+}
+
+uint8_t LedCompositor::scrollText(uint8_t layer, int8_t y, const char* text, uint32_t color, uint8_t stepsPerColumn)
+{
+    if (layer >= MAX_LAYERS) return INVALID_ID;
+
+    for (uint8_t id = 0; id < MAX_SCROLLERS; id++) {
+        Scroller& scroller = scrollers[id];
+        if (scroller.active) continue;
+
+        uint8_t length = 0;
+        while (text[length] != '\0' && length < MAX_SCROLL_TEXT - 1) {
+            scroller.text[length] = text[length];
+            length++;
+        }
+        scroller.text[length] = '\0';
+        scroller.textWidth = length * TEXT_FONT.width;
+        scroller.x = LedMatrix::WIDTH;
+        scroller.color = color;
+        scroller.y = y;
+        scroller.layer = layer;
+        scroller.stepsPerColumn = stepsPerColumn > 0 ? stepsPerColumn : 1;
+        scroller.stepCounter = 0;
+        scroller.active = true;
+        drawScroller(scroller);
+        return id;
+    }
+    return INVALID_ID;
+}
+
+void LedCompositor::stopScroll(uint8_t id)
+{
+    if (id >= MAX_SCROLLERS || !scrollers[id].active) return;
+    Scroller& scroller = scrollers[id];
+    clearRect(scroller.layer, 0, scroller.y, LedMatrix::WIDTH, GLYPH_HEIGHT);
+    scroller.active = false;
+}
+
+void LedCompositor::composeRow(uint8_t y, uint32_t (&row)[LedMatrix::WIDTH]) const
+{
+    // Higher layers are painted last and end up on top
+    for (const Layer& layer : layers) {
+        uint16_t bits = layer.mask[y];
+        if (bits == 0) continue;
+        const uint32_t* colors = &layer.colors[y * LedMatrix::WIDTH];
+        for (uint8_t x = 0; x < LedMatrix::WIDTH; x++) {
+            if (bits & (1u << x)) row[x] = colors[x];
+        }
+    }
+}
+
+void LedCompositor::step()
+{
+    for (Animation& animation : animations) {
+        if (animation.active) stepAnimation(animation);
+    }
+    for (Scroller& scroller : scrollers) {
+        if (scroller.active) stepScroller(scroller);
+    }
+}
+
+void LedCompositor::stepAnimation(Animation& animation)
+{
+    const Keyframe& last = animation.keyframes[animation.count - 1];
+    if (animation.step > last.step) {
+        if (!animation.loop || last.step == 0) {
+            if (animation.drawn) {
+                clearRect(animation.layer, animation.drawnX, animation.drawnY, animation.width, animation.height);
+            }
+            animation.active = false;
+            return;
+        }
+        animation.step = 0;
+    }
+
+    // Keyframes around the current step
+    uint8_t next = 0;
+    while (next < animation.count - 1 && animation.keyframes[next].step <= animation.step) {
+        next++;
+    }
+    const Keyframe& to = animation.keyframes[next];
+    const Keyframe& from = next > 0 ? animation.keyframes[next - 1] : to;
+
+    int8_t x = to.x;
+    int8_t y = to.y;
+    uint32_t color = to.color;
+    uint32_t span = to.step - from.step;
+    if (span > 0 && animation.step < to.step) {
+        uint32_t position = animation.step - from.step;
+        x = static_cast<int8_t>(from.x + (to.x - from.x) * static_cast<int32_t>(position) / static_cast<int32_t>(span));
+        y = static_cast<int8_t>(from.y + (to.y - from.y) * static_cast<int32_t>(position) / static_cast<int32_t>(span));
+        color = (static_cast<uint32_t>(lerpChannel(from.color, to.color, 16, position, span)) << 16) |
+            (static_cast<uint32_t>(lerpChannel(from.color, to.color, 8, position, span)) << 8) |
+            lerpChannel(from.color, to.color, 0, position, span);
+    }
+    animation.step++;
+
+    // Unchanged steps leave the layer and the matrix alone
+    if (animation.drawn && x == animation.drawnX && y == animation.drawnY && color == animation.drawnColor) return;
+
+    if (animation.drawn) {
+        clearRect(animation.layer, animation.drawnX, animation.drawnY, animation.width, animation.height);
+    }
+    fillRect(animation.layer, x, y, animation.width, animation.height, color);
+    animation.drawnX = x;
+    animation.drawnY = y;
+    animation.drawnColor = color;
+    animation.drawn = true;
+}
+
+void LedCompositor::stepScroller(Scroller& scroller)
+{
+    if (++scroller.stepCounter < scroller.stepsPerColumn) return;
+    scroller.stepCounter = 0;
+
+    scroller.x--;
+    if (scroller.x < -scroller.textWidth) {
+        scroller.x = LedMatrix::WIDTH;
+    }
+    drawScroller(scroller);
+}
+
+void LedCompositor::drawScroller(const Scroller& scroller)
+{
+    Layer& layer = layers[scroller.layer];
+    for (int16_t y = scroller.y; y < scroller.y + GLYPH_HEIGHT; y++) {
+        if (y < 0 || y >= LedMatrix::HEIGHT) continue;
+        memset(&layer.colors[y * LedMatrix::WIDTH], 0, LedMatrix::WIDTH * sizeof(uint32_t));
+        layer.mask[y] = 0xFFFF;
+    }
+    blit_text(&layer.colors, TEXT_FONT, scroller.text, scroller.x, scroller.y, scroller.color);
+    invalidateRows(scroller.y, GLYPH_HEIGHT);
+}
+
+void LedCompositor::invalidateRows(int16_t y, int16_t height)
+{
+    matrix.invalidateRows(y, height);
+}
+
+} // namespace hardware
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <cstdint>
+#include "LedMatrix.h"
+
+namespace hardware {
+
+// Position and color of an animated rectangle at a point in time
+struct Keyframe {
+    uint16_t step;      // fixed steps since the animation started
+    int8_t x;
+    int8_t y;
+    uint32_t color;
+};
+
+// Layers, scrolling text and keyframed animations on top of what the views draw on a LedMatrix.
+//
+// Every layer has a color per pixel and a mask bit per pixel: masked pixels cover the layers
+// below and the view's drawing, the others are transparent. Animations advance in fixed steps
+// from update(), and the rows they touch are composed into the matrix frame when it is committed,
+// so bursts of animation still cost at most one frame per LedMatrix frame interval. All storage
+// is fixed, nothing is allocated after construction.
+class LedCompositor {
+public:
+    static constexpr uint8_t MAX_LAYERS = 4;
+    static constexpr uint8_t MAX_ANIMATIONS = 8;
+    static constexpr uint8_t MAX_KEYFRAMES = 4;
+    static constexpr uint8_t MAX_SCROLLERS = 2;
+    static constexpr uint8_t MAX_SCROLL_TEXT = 32;
+    static constexpr uint8_t INVALID_ID = 0xFF;
+    // Animation ids hold the slot in the low bits and a generation above, so an id kept after its
+    // animation ended never matches the next animation in the same slot
+    static constexpr uint8_t ANIMATION_SLOT_BITS = 3;
+    static constexpr uint8_t ANIMATION_GENERATIONS = (0xFF >> ANIMATION_SLOT_BITS);   // skips INVALID_ID
+    static_assert(MAX_ANIMATIONS == 1 << ANIMATION_SLOT_BITS, "animation slots must fill the slot bits");
+    static constexpr uint32_t STEP_US = 1000000 / 60;
+    // After a longer stall the clock skips ahead instead of catching up step by step
+    static constexpr uint8_t MAX_CATCH_UP_STEPS = 4;
+
+    explicit LedCompositor(LedMatrix& matrix);
+    ~LedCompositor();
+
+    // Advance animations and scrollers by the fixed steps due at nowUs
+    void update(uint32_t nowUs);
+
+    void clearLayer(uint8_t layer);
+    void setPixel(uint8_t layer, uint8_t x, uint8_t y, uint32_t color);
+    void clearPixel(uint8_t layer, uint8_t x, uint8_t y);
+    void fillRect(uint8_t layer, int8_t x, int8_t y, uint8_t width, uint8_t height, uint32_t color);
+    void clearRect(uint8_t layer, int8_t x, int8_t y, uint8_t width, uint8_t height);
+
+    /**
+     * @brief Move and fade a rectangle along keyframes
+     *
+     * Position and color are interpolated linearly between keyframes, which must be sorted by
+     * step and are copied. A finished animation that does not loop clears its rectangle.
+     *
+     * Animations that overlap on one layer share its mask bits, so a caller restarting an effect
+     * at the same spot should stop the previous one first.
+     *
+     * @return Animation id for stopAnimation(), INVALID_ID if all slots are busy
+     */
+    uint8_t animate(uint8_t layer, uint8_t width, uint8_t height, const Keyframe* keyframes, uint8_t count, bool loop);
+    // Does nothing for INVALID_ID or an animation that already ended
+    void stopAnimation(uint8_t id);
+
+    /**
+     * @brief Scroll text from right to left through rows y to y + 4, repeating
+     *
+     * The band is opaque while the text scrolls. The text is copied, up to MAX_SCROLL_TEXT - 1
+     * characters.
+     *
+     * @return Scroller id for stopScroll(), INVALID_ID if all slots are busy
+     */
+    uint8_t scrollText(uint8_t layer, int8_t y, const char* text, uint32_t color, uint8_t stepsPerColumn);
+    void stopScroll(uint8_t id);
+
+    // Called by LedMatrix when it commits a row: paints the masked layer pixels over it
+    void composeRow(uint8_t y, uint32_t (&row)[LedMatrix::WIDTH]) const;
+
+private:
+    struct Layer {
+        uint32_t colors[LedMatrix::NUM_PIXELS];
+        uint16_t mask[LedMatrix::HEIGHT];   // bit x of row y set: the pixel covers what is below
+    };
+
+    struct Animation {
+        Keyframe keyframes[MAX_KEYFRAMES];
+        uint16_t step;
+        uint8_t count;
+        uint8_t layer;
+        uint8_t width;
+        uint8_t height;
+        bool loop;
+        bool active;
+        uint8_t generation;
+        // Rectangle drawn in the previous step, erased before the next one
+        int8_t drawnX;
+        int8_t drawnY;
+        uint32_t drawnColor;
+        bool drawn;
+    };
+
+    struct Scroller {
+        char text[MAX_SCROLL_TEXT];
+        int16_t x;
+        int16_t textWidth;
+        uint32_t color;
+        int8_t y;
+        uint8_t layer;
+        uint8_t stepsPerColumn;
+        uint8_t stepCounter;
+        bool active;
+    };
+
+    LedMatrix& matrix;
+    Layer layers[MAX_LAYERS];
+    Animation animations[MAX_ANIMATIONS];
+    Scroller scrollers[MAX_SCROLLERS];
+    uint32_t lastStepUs;
+    bool started;
+
+    void step();
+    void stepAnimation(Animation& animation);
+    void stepScroller(Scroller& scroller);
+    void drawScroller(const Scroller& scroller);
+    void invalidateRows(int16_t y, int16_t height);
+};
+
+} // namespace hardware
@@ -1,64 +1,177 @@
 #include "LedMatrix.h"
+#include "LedCompositor.h"
 #include "driver/ws2812_dma.h"
 #include "driver/led_matrix_pattern.h"
+#include "../../common/profiler.h"
+#include "hardware/timer.h"
 #include <cstring>
 
 namespace hardware {
 
+PROFILE_ZONE(updateZone, "LedMatrix::update");
+
+// Perceived brightness to PWM duty, round(255 * (i / 255)^2.2)
+static const uint8_t GAMMA[256] = {
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   1,
+      1,   1,   1,   1,   1,   1,   1,   1,   1,   2,   2,   2,   2,   2,   2,   2,
+      3,   3,   3,   3,   3,   4,   4,   4,   4,   5,   5,   5,   5,   6,   6,   6,
+      6,   7,   7,   7,   8,   8,   8,   9,   9,   9,  10,  10,  11,  11,  11,  12,
+     12,  13,  13,  13,  14,  14,  15,  15,  16,  16,  17,  17,  18,  18,  19,  19,
+     20,  20,  21,  22,  22,  23,  23,  24,  25,  25,  26,  26,  27,  28,  28,  29,
+     30,  30,  31,  32,  33,  33,  34,  35,  35,  36,  37,  38,  39,  39,  40,  41,
+     42,  43,  43,  44,  45,  46,  47,  48,  49,  49,  50,  51,  52,  53,  54,  55,
+     56,  57,  58,  59,  60,  61,  62,  63,  64,  65,  66,  67,  68,  69,  70,  71,
+     73,  74,  75,  76,  77,  78,  79,  81,  82,  83,  84,  85,  87,  88,  89,  90,
+     91,  93,  94,  95,  97,  98,  99, 100, 102, 103, 105, 106, 107, 109, 110, 111,
+    113, 114, 116, 117, 119, 120, 121, 123, 124, 126, 127, 129, 130, 132, 133, 135,
+    137, 138, 140, 141, 143, 145, 146, 148, 149, 151, 153, 154, 156, 158, 159, 161,
+    163, 165, 166, 168, 170, 172, 173, 175, 177, 179, 181, 182, 184, 186, 188, 190,
+    192, 194, 196, 197, 199, 201, 203, 205, 207, 209, 211, 213, 215, 217, 219, 221,
+    223, 225, 227, 229, 231, 234, 236, 238, 240, 242, 244, 246, 248, 251, 253, 255,
+};
+
 LedMatrix::LedMatrix(uint8_t pin) :
     pin(pin),
-    buffer{},
-    dirty(false)
+    canvas{},
+    frames{},
+    back(0),
+    dirtyRows(0),
+    brightness(DEFAULT_BRIGHTNESS),
+    overlay(nullptr),
+    frameIntervalUs(1000000 / DEFAULT_MAX_FPS),
+    lastFrameUs(0)
 {
+    buildLevels();
     ws2812_dma_init(pin);
 }
 
 void LedMatrix::update()
 {
-    if (!dirty) return;
+    if (dirtyRows == 0) return;
+    // Bursts of drawing within one frame interval go out as a single frame
+    uint32_t now = time_us_32();
+    if (now - lastFrameUs < frameIntervalUs) return;
+    PROFILE_SCOPE(updateZone);
+
+    // Commit the drawn rows through the level table. Redrawing the same content, e.g. on every
+    // pot jitter, does not cost a transfer.
+    uint8_t front = back ^ 1;
+    uint16_t changedRows = 0;
+    for (uint8_t row = 0; row < HEIGHT; row++) {
+        if (!(dirtyRows & (1u << row))) continue;
+        uint32_t source[WIDTH];
+        memcpy(source, &canvas[row * WIDTH], sizeof(source));
+        if (overlay != nullptr) overlay->composeRow(row, source);
+
+        uint32_t* target = &frames[back][row * WIDTH];
+        for (uint8_t x = 0; x < WIDTH; x++) {
+            uint32_t color = source[x];
+            target[x] = ws2812_wire(urgb_u32(levels[(color >> 8) & 0xFF], levels[(color >> 16) & 0xFF],
+                levels[color & 0xFF]));
+        }
+        if (memcmp(target, &frames[front][row * WIDTH], WIDTH * sizeof(uint32_t)) != 0) {
+            changedRows |= 1u << row;
+        }
+    }
+    if (changedRows == 0) {
+        dirtyRows = 0;
+        return;
+    }
+
+    // Previous frame still on the wire, the canvas keeps collecting changes until it is done
+    if (!ws2812_dma_ready()) return;
+
+    ws2812_dma_transfer(frames[back]);
+    lastFrameUs = now;
+    dirtyRows = 0;
+
+    // Rows that are not drawn to are never converted again, so the new back frame has to match
+    // the LEDs. It only lacks the changed rows. The DMA only reads the front frame.
+    front = back;
+    back = front ^ 1;
+    for (uint8_t row = 0; row < HEIGHT; row++) {
+        if (changedRows & (1u << row)) {
+            memcpy(&frames[back][row * WIDTH], &frames[front][row * WIDTH], WIDTH * sizeof(uint32_t));
+        }
+    }
+}
+
+void LedMatrix::setMaxFrameRate(uint8_t maxFps)
+{
+    frameIntervalUs = maxFps > 0 ? 1000000 / maxFps : 0;
+}
 
-    ws2812_put_pixels(buffer);
-    ws2812_dma_handle();
-    dirty = false;
+void LedMatrix::setBrightness(uint8_t brightness)
+{
+    if (brightness == this->brightness) return;
+    this->brightness = brightness;
+    buildLevels();
+    markRows(0, HEIGHT);
+}
+
+void LedMatrix::buildLevels()
+{
+    for (uint16_t i = 0; i < 256; i++) {
+        levels[i] = static_cast<uint8_t>((GAMMA[i] * (brightness + 1)) >> 8);
+    }
+}
+
+void LedMatrix::markRows(int16_t first, int16_t count)
+{
+    // Clip to the matrix, drawing may start above or run below it
+    if (first < 0) {
+        count += first;
+        first = 0;
+    }
+    if (first + count > HEIGHT) count = HEIGHT - first;
+    if (count <= 0) return;
+    dirtyRows |= ((1u << count) - 1) << first;
 }
 
 void LedMatrix::clear()
 {
-    memset(buffer, 0, sizeof(buffer));
-    dirty = true;
+    memset(canvas, 0, sizeof(canvas));
+    markRows(0, HEIGHT);
 }
 
 void LedMatrix::setPixel(uint8_t x, uint8_t y, uint32_t color)
 {
     if (x >= WIDTH || y >= HEIGHT) return;
-    buffer[y * WIDTH + x] = color;
-    dirty = true;
+    canvas[y * WIDTH + x] = color;
+    markRows(y, 1);
 }
 
 void LedMatrix::fill(uint32_t color)
 {
     for (uint16_t i = 0; i < NUM_PIXELS; i++) {
-        buffer[i] = color;
+        canvas[i] = color;
     }
-    dirty = true;
+    markRows(0, HEIGHT);
 }
 
 void LedMatrix::drawNumber(int number, uint32_t color)
 {
-    get_number_pattern(&number, &buffer, &color);
-    dirty = true;
+    get_number_pattern(&number, &canvas, &color);
+    markRows(6, 10);
 }
 
 void LedMatrix::drawLabel(const char (&text)[4], uint32_t color)
 {
-    get_label_pattern(&text, &buffer, &color);
-    dirty = true;
+    get_label_pattern(&text, &canvas, &color);
+    markRows(0, 5);
 }
 
 void LedMatrix::drawNote(const char (&noteStr)[3], uint32_t color)
 {
-    get_note_pattern(&noteStr, &buffer, &color);
-    dirty = true;
+    get_note_pattern(&noteStr, &canvas, &color);
+    markRows(6, 10);
+}
+
+int16_t LedMatrix::drawText(int16_t x, int8_t y, const char* text, uint32_t color, uint8_t scale)
+{
+    int end = blit_text(&canvas, TEXT_FONT, text, x, y, color, scale, scale);
+    markRows(y, GLYPH_HEIGHT * scale);
+    return static_cast<int16_t>(end);
 }
 
 } // namespace hardware
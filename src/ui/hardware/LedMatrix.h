@@ -4,15 +4,29 @@
 
 namespace hardware {
 
+class LedCompositor;
+
 class LedMatrix {
 public:
     static constexpr uint16_t NUM_PIXELS = 256;
     static constexpr uint8_t WIDTH = 16;
     static constexpr uint8_t HEIGHT = 16;
+    static constexpr uint8_t DEFAULT_MAX_FPS = 60;
+    static constexpr uint8_t DEFAULT_BRIGHTNESS = 255;
 
     LedMatrix(uint8_t pin);
 
+    // Sends the drawn frame if it differs from the one on the LEDs, at most maxFps times a second
     void update();
+    void setMaxFrameRate(uint8_t maxFps);
+    // Scales every channel after gamma correction, lower values also cap the current draw
+    void setBrightness(uint8_t brightness);
+    uint8_t getBrightness() const { return brightness; }
+
+    // Layers painted over the canvas when rows are committed, nullptr for none
+    void setOverlay(const LedCompositor* overlay) { this->overlay = overlay; }
+    // Commit the rows again with the next frame, e.g. after the overlay changed them
+    void invalidateRows(int16_t first, int16_t count) { markRows(first, count); }
 
     void clear();
     void setPixel(uint8_t x, uint8_t y, uint32_t color);
@@ -20,11 +34,30 @@ public:
     void drawNumber(int number, uint32_t color);
     void drawLabel(const char (&text)[4], uint32_t color);
     void drawNote(const char (&noteStr)[3], uint32_t color);
+    // Printable ASCII in 3x5 glyphs from column x on, clipped at the edges (x may be negative for
+    // scrolling). Returns the column after the text.
+    int16_t drawText(int16_t x, int8_t y, const char* text, uint32_t color, uint8_t scale = 1);
 
 private:
     uint8_t pin;
-    uint32_t buffer[NUM_PIXELS];
-    bool dirty;
+    // What the views draw, in perceptual GRB colors (see urgb_u32()), gamma is applied on commit
+    uint32_t canvas[NUM_PIXELS];
+    // Frames as the PIO shifts them out (see ws2812_wire()). update() converts the drawn rows of
+    // the canvas into the back frame, hands it to the DMA in place and switches to the other one.
+    // The rows that changed are then copied into the new back frame, so it matches the LEDs.
+    uint32_t frames[2][NUM_PIXELS];
+    uint8_t back;
+    // Canvas rows drawn to since the last frame, one bit per row
+    uint16_t dirtyRows;
+    // Gamma correction and brightness in one step, per channel
+    uint8_t levels[256];
+    uint8_t brightness;
+    const LedCompositor* overlay;
+    uint32_t frameIntervalUs;
+    uint32_t lastFrameUs;
+
+    void markRows(int16_t first, int16_t count);
+    void buildLevels();
 };
 
 } // namespace hardware
@@ -2,7 +2,7 @@
 #include "hardware/adc.h"
 #include "../Event.h"
 #include "../state/StateManager.h"
-#include <cstdio>
+#include "../../common/log.h"
 
 namespace hardware {
 
@@ -30,7 +30,7 @@ void Potentiometer::update()
     }
     uint16_t filtered = static_cast<uint16_t>(smoothedValue >> SMOOTHING_SHIFT);
 
-    printf("raw=%d filtered=%d\n", reading, filtered);
+    LOG_DEBUG("raw=%d filtered=%d\n", reading, filtered);
 
     int16_t diff = static_cast<int16_t>(filtered) - static_cast<int16_t>(currentValue);
     if (diff < 0) diff = -diff;
@@ -39,7 +39,7 @@ void Potentiometer::update()
     {
         currentValue = filtered;
         ui::events::Event event = ui::events::Event::potChanged(potId, currentValue);
-        ui::state::getStateManager().dispatch(event);
+        ui::state::getStateManager().post(event);
     }
 }
 
@@ -19,10 +19,14 @@
 #else
 #include <hardware/gpio.h>
 #include <hardware/i2c.h>
+#include <hardware/dma.h>
 #include <pico/binary_info.h>
 #include <string.h>
 #include <cstdint>
 #include "LCD_I2C.hpp"
+#include "../../../common/profiler.h"
+
+PROFILE_ZONE(showZone, "LCD_I2C::show");
 #endif
 
 
@@ -46,6 +50,18 @@ LCD_I2C::LCD_I2C(byte address, byte columns, byte rows, i2c_inst* I2C) :
 {
     if (rows > MAX_LINES) _rows = MAX_LINES; // check against limits
     if (columns > MAX_CHARS) _cols = MAX_CHARS;
+
+    // DMA writes queued data command words straight into the I2C TX FIFO
+    i2c_hw_t* hw = i2c_get_hw(I2C_instance);
+    hw->dma_cr = I2C_IC_DMA_CR_TDMAE_BITS;
+    _txDmaChannel = dma_claim_unused_channel(true);
+    dma_channel_config config = dma_channel_get_default_config(_txDmaChannel);
+    channel_config_set_transfer_data_size(&config, DMA_SIZE_16);
+    channel_config_set_read_increment(&config, true);
+    channel_config_set_write_increment(&config, false);
+    channel_config_set_dreq(&config, i2c_get_dreq(I2C_instance, true));
+    dma_channel_configure(_txDmaChannel, &config, &hw->data_cmd, NULL, 0, false);
+
     init();
 }
 #endif
@@ -105,13 +121,13 @@ void LCD_I2C::send_byte(byte val, int  mode, bool Enable_Buffering)
 void LCD_I2C::clear(void)
 {
     send_byte(LCD_CLEARDISPLAY, LCD_COMMAND);
-    sleep_us(2000); // command takes a long time
+    delay_us(2000); // command takes a long time
 }
 
 void LCD_I2C::home(void)
 {
     send_byte(LCD_RETURNHOME, LCD_COMMAND);
-    sleep_us(2000); // command takes a long time
+    delay_us(2000); // command takes a long time
 }
 
 // go to location on LCD
@@ -179,14 +195,14 @@ void LCD_I2C::init()
 
     // Need to wait 40 ms for display to stabilize    
 
-    sleep_ms(50);                   // Need 40 msec after display power up
+    delay_us(50000);                // Need 40 msec after display power up
     write_byte(_backlight);         // Set expander interface outputs low with backlight
     send_byte(0x03, LCD_COMMAND);   // set 4 bit mode three times ...
-    sleep_us(4500);                 // Hitachi HD44780 datasheet pg 46
+    delay_us(4500);                 // Hitachi HD44780 datasheet pg 46
     send_byte(0x03, LCD_COMMAND); // two ...
-    sleep_us(4500);
+    delay_us(4500);
     send_byte(0x03, LCD_COMMAND); // three
-    sleep_us(150);
+    delay_us(150);
     send_byte(0x02, LCD_COMMAND);
 
     send_byte(_displaymode, LCD_COMMAND);
@@ -197,6 +213,9 @@ void LCD_I2C::init()
 
 int LCD_I2C::show()
 {
+#ifndef ARDUINO
+    PROFILE_SCOPE(showZone);
+#endif
     int i = _bufferIn;
 
     if (_bufferIn > 0) {  //If there is data in the buffer,...
@@ -207,8 +226,8 @@ int LCD_I2C::show()
         Wire.write(_buffer, _bufferIn);
         Wire.endTransmission();
 #else
-// For Pi Pico, we do an I2C write pointing at our own buffer
-        i2c_write_blocking(I2C_instance, _Addr, _buffer, _bufferIn, false);
+// For Pi Pico, the buffer is queued as one transaction and sent in the background
+        queue_segment(_buffer, _bufferIn, 0);
 #endif
     }
     _bufferIn = 0;  // and set the buffer to empty
@@ -216,6 +235,123 @@ int LCD_I2C::show()
 
 }
 
+#ifdef ARDUINO
+void LCD_I2C::delay_us(uint32_t time)
+{
+    show();
+    sleep_us(time);
+}
+#else
+void LCD_I2C::delay_us(uint32_t time)
+{
+    show();     // the delay starts after everything written so far
+    queue_segment(NULL, 0, time);
+}
+
+void LCD_I2C::queue_segment(const byte* data, size_t length, uint32_t delayUs)
+{
+    // Segments are never split at the end of the word ring, so DMA can send each in one go
+    uint32_t position = _txWordHead;
+    uint32_t toEnd = TX_WORDS - (position & (TX_WORDS - 1));
+    uint32_t skip = (length > 0 && toEnd < length) ? toEnd : 0;
+
+    // Queue full: keep the bus busy until there is room. Only a burst larger than the queue waits.
+    while (_txSegmentHead - _txSegmentTail >= TX_SEGMENTS ||
+        (position - _txWordTail) + skip + length > TX_WORDS) {
+        service();
+    }
+
+    position += skip;
+    uint16_t start = position & (TX_WORDS - 1);
+    for (size_t i = 0; i < length; i++) {
+        // The last byte ends the transaction
+        _txWords[start + i] = data[i] | (i + 1 == length ? I2C_IC_DATA_CMD_STOP_BITS : 0);
+    }
+
+    TxSegment& segment = _txSegments[_txSegmentHead & (TX_SEGMENTS - 1)];
+    segment.end = position + length;
+    segment.start = start;
+    segment.count = length;
+    segment.delayUs = delayUs;
+    _txWordHead = position + length;
+    _txSegmentHead++;
+
+    service();
+}
+
+void LCD_I2C::start_segment(const TxSegment& segment)
+{
+    if (segment.count == 0) {
+        _txDelayEnd = time_us_32() + segment.delayUs;
+        return;
+    }
+
+    // The target address can only change while the controller is disabled
+    i2c_hw_t* hw = i2c_get_hw(I2C_instance);
+    hw->enable = 0;
+    hw->tar = _Addr;
+    hw->enable = 1;
+
+    dma_channel_set_trans_count(_txDmaChannel, segment.count, false);
+    dma_channel_set_read_addr(_txDmaChannel, &_txWords[segment.start], true);
+}
+
+int LCD_I2C::service()
+{
+    i2c_hw_t* hw = i2c_get_hw(I2C_instance);
+
+    while (true) {
+        if (_txBusy) {
+            const TxSegment& segment = _txSegments[_txSegmentTail & (TX_SEGMENTS - 1)];
+            if (segment.count == 0) {
+                if ((int32_t)(time_us_32() - _txDelayEnd) < 0) break;
+            }
+            else {
+                bool aborted = hw->raw_intr_stat & I2C_IC_RAW_INTR_STAT_TX_ABRT_BITS;
+                if (!aborted) {
+                    if (dma_channel_is_busy(_txDmaChannel) || hw->txflr > 0 || (hw->status & I2C_IC_STATUS_ACTIVITY_BITS)) {
+                        break;
+                    }
+                    // A NACK between the two reads also leaves the FIFO empty, the latched abort
+                    // would otherwise cost the next transaction
+                    aborted = hw->raw_intr_stat & I2C_IC_RAW_INTR_STAT_TX_ABRT_BITS;
+                }
+                if (aborted) {
+                    // Not acknowledged, the controller flushed its FIFO. Drop the rest of the transaction.
+                    dma_channel_abort(_txDmaChannel);
+                    (void)hw->clr_tx_abrt;
+                    _txErrors++;
+                }
+            }
+
+            _txWordTail = segment.end;
+            _txSegmentTail++;
+            _txBusy = false;
+        }
+
+        if (_flushCallback != NULL && (int32_t)(_txSegmentTail - _flushTarget) >= 0) {
+            void (*callback)(void*) = _flushCallback;
+            _flushCallback = NULL;
+            callback(_flushContext);
+        }
+
+        if (_txSegmentTail == _txSegmentHead) break;
+        start_segment(_txSegments[_txSegmentTail & (TX_SEGMENTS - 1)]);
+        _txBusy = true;
+    }
+    return _txSegmentHead - _txSegmentTail;
+}
+
+void LCD_I2C::flush(void (*callback)(void* context), void* context)
+{
+    show();
+    _flushCallback = callback;
+    _flushContext = context;
+    _flushTarget = _txSegmentHead;
+    service();
+}
+#endif
+
 void LCD_I2C::backlight(void)
 {
     _backlight = LCD_BACKLIGHT;
@@ -298,7 +434,7 @@ void LCD_I2C::leftToRight(void)
     send_byte(_displaymode, LCD_COMMAND);
 }
 
-void LCD_I2C::createChar(byte charnum, const byte char_map[])
+void LCD_I2C::createChar(byte charnum, const byte char_map[], bool Enable_Buffering)
 {
 #define MAXCHARNUM 7
 #define CUSTOMCHARSIZE 8
@@ -307,7 +443,7 @@ void LCD_I2C::createChar(byte charnum, const byte char_map[])
     for (int i = 0;i < CUSTOMCHARSIZE;i++) {
         send_byte(char_map[i], LCD_CHARACTER, true);
     }
-    setCursor(0, 0); // go back to data ram addressing (and flush buffer)
+    setCursor(0, 0, Enable_Buffering); // go back to data ram addressing (and flush buffer unless buffering)
 }
 
 #ifndef ARDUINO
@@ -168,8 +168,49 @@ private:
     */
 #ifndef ARDUINO
     i2c_inst* I2C_instance{ nullptr };
+
+    /*
+     * On the Pi Pico, show() does not wait for the bus. The buffer becomes one I2C
+     * transaction in a transmit queue of data command words, which DMA feeds to the
+     * I2C controller while the caller carries on. Command delays are queue entries
+     * too, so nothing ever sleeps. service() moves the queue along.
+     */
+    static constexpr size_t TX_WORDS = 512;     // must be a power of two
+    static constexpr size_t TX_SEGMENTS = 32;   // must be a power of two
+
+    struct TxSegment {
+        uint32_t end;       // word position after this segment, frees the words once sent
+        uint16_t start;     // first word in _txWords, segments never wrap
+        uint16_t count;     // 0 for a delay
+        uint32_t delayUs;
+    };
+
+    uint16_t _txWords[TX_WORDS];
+    TxSegment _txSegments[TX_SEGMENTS];
+    uint32_t _txWordHead = 0;       // free running positions
+    uint32_t _txWordTail = 0;
+    uint32_t _txSegmentHead = 0;    // segments queued
+    uint32_t _txSegmentTail = 0;    // segments finished
+    bool _txBusy = false;           // segment at _txSegmentTail is being sent or waited for
+    uint32_t _txDelayEnd = 0;
+    int _txDmaChannel = -1;
+    uint32_t _txErrors = 0;
+
+    void (*_flushCallback)(void* context) = nullptr;
+    void* _flushContext = nullptr;
+    uint32_t _flushTarget = 0;
+
+    void queue_segment(const byte* data, size_t length, uint32_t delayUs) noexcept;
+    void start_segment(const TxSegment& segment) noexcept;
 #endif
 
+    /**
+     * Wait before the next byte reaches the display, e.g. for slow commands.
+     *
+     * On the Pi Pico this queues a delay and returns at once.
+     */
+    void delay_us(uint32_t time) noexcept;
+
     /**
      * Output a byte to the interface chip.
      *
@@ -688,12 +729,14 @@ public:
       * character dots starting with the top-most row. The lsb of each byte is the right-most
       * dot on its corresponding line of the character.
       *
-      * This command causes the buffer to be output to the display before execution.
+      * Afterwards the cursor is at the top left (0,0) location.
       *
       * @param charnum The memory address (character code) 0-7
       * @param char_map The byte array
+      * @param Enable_Buffering If true, the command is simply added to the output buffer.
+      * If false or missing, the buffer is immediately written to the display.
       */
-    void createChar(byte charnum, const byte char_map[])  noexcept;
+    void createChar(byte charnum, const byte char_map[], bool Enable_Buffering = false)  noexcept;
     /**
      * @brief An alias for createChar() for loading custom character data
      *
@@ -724,9 +767,50 @@ public:
       * may generate 4 or 5 bytes of output to be transmitted, so this will *not* match the number of characters
       * or comands written.
       *
+      * On the Pi Pico the bytes are queued as one transaction and sent by DMA, see service().
+      *
       */
     int show(void) noexcept;
     ///@}
+#ifndef ARDUINO
+
+    /**
+     * @name Asynchronous Transmission on the Pi Pico
+     *
+     * show(), and every call that does not buffer, only queues its bytes. service() must be
+     * called regularly, e.g. from the UI loop, to send them.
+     */
+     ///@{
+
+     /**
+      * @brief Start the next queued transaction or delay once the previous one is done
+      *
+      * Never waits. Calls the flush callback once its data has been sent.
+      *
+      * @return (int) The number of queued transactions and delays not finished yet
+      */
+    int service(void) noexcept;
+
+    /**
+     * @brief Send the buffer and get called back once everything queued so far is on the display
+     *
+     * The callback runs from service(). A later flush() replaces a pending callback.
+     */
+    void flush(void (*callback)(void* context), void* context) noexcept;
+
+    /** @brief True when nothing is buffered, queued or in flight */
+    inline bool isIdle(void) const noexcept
+    {
+        return _txSegmentTail == _txSegmentHead && _bufferIn == 0;
+    };
+
+    /** @brief Transactions dropped because the display did not acknowledge */
+    inline uint32_t getErrorCount(void) const noexcept
+    {
+        return _txErrors;
+    };
+    ///@}
+#endif
 #ifdef ARDUINO
 ///@endcond 
 #endif
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <stdint.h>
+
+// Custom characters for the HD44780 LCD: 8 rows of 5 dots, top row first, bit 0 is the rightmost dot.
+// Only 8 fit into the LCD's CGRAM at once, Display uploads them on demand.
+static constexpr uint8_t LCD_GLYPH_ROWS = 8;
+
+enum LcdGlyph : uint8_t {
+    // Partial bar graph cells with 1 to 4 of 5 columns filled, a full cell is the LCD's own 0xFF
+    LCD_GLYPH_BAR_1,
+    LCD_GLYPH_BAR_2,
+    LCD_GLYPH_BAR_3,
+    LCD_GLYPH_BAR_4,
+    // Transport state
+    LCD_GLYPH_PLAY,
+    LCD_GLYPH_PAUSE,
+    LCD_GLYPH_STOP,
+    LCD_GLYPH_RECORD,
+    // Step grid, the playhead variants are underlined
+    LCD_GLYPH_STEP_OFF,
+    LCD_GLYPH_STEP_ON,
+    LCD_GLYPH_STEP_OFF_PLAYHEAD,
+    LCD_GLYPH_STEP_ON_PLAYHEAD,
+    LCD_GLYPH_COUNT
+};
+
+// Glyph ids share the character codes 0x00 to 0x0F with CGRAM, which text never uses
+static_assert(LCD_GLYPH_COUNT <= 16, "glyph ids must stay below 0x10");
+
+static constexpr uint8_t LCD_FULL_BLOCK = 0xFF;
+static constexpr uint8_t LCD_BAR_STEPS = 5;     // columns per bar graph cell
+
+static constexpr uint8_t LCD_GLYPHS[LCD_GLYPH_COUNT][LCD_GLYPH_ROWS] = {
+    { 0b10000, 0b10000, 0b10000, 0b10000, 0b10000, 0b10000, 0b10000, 0b10000 },   // BAR_1
+    { 0b11000, 0b11000, 0b11000, 0b11000, 0b11000, 0b11000, 0b11000, 0b11000 },   // BAR_2
+    { 0b11100, 0b11100, 0b11100, 0b11100, 0b11100, 0b11100, 0b11100, 0b11100 },   // BAR_3
+    { 0b11110, 0b11110, 0b11110, 0b11110, 0b11110, 0b11110, 0b11110, 0b11110 },   // BAR_4
+    { 0b10000, 0b11000, 0b11100, 0b11110, 0b11100, 0b11000, 0b10000, 0b00000 },   // PLAY
+    { 0b00000, 0b11011, 0b11011, 0b11011, 0b11011, 0b11011, 0b00000, 0b00000 },   // PAUSE
+    { 0b00000, 0b11111, 0b11111, 0b11111, 0b11111, 0b11111, 0b00000, 0b00000 },   // STOP
+    { 0b00000, 0b01110, 0b11111, 0b11111, 0b11111, 0b01110, 0b00000, 0b00000 },   // RECORD
+    { 0b01110, 0b10001, 0b10001, 0b10001, 0b10001, 0b01110, 0b00000, 0b00000 },   // STEP_OFF
+    { 0b01110, 0b11111, 0b11111, 0b11111, 0b11111, 0b01110, 0b00000, 0b00000 },   // STEP_ON
+    { 0b01110, 0b10001, 0b10001, 0b10001, 0b10001, 0b01110, 0b00000, 0b11111 },   // STEP_OFF_PLAYHEAD
+    { 0b01110, 0b11111, 0b11111, 0b11111, 0b11111, 0b01110, 0b00000, 0b11111 },   // STEP_ON_PLAYHEAD
+};
@@ -1,363 +1,227 @@
+#pragma once
+
 #include <stdint.h>
-#include <stdbool.h>
 
-// 6x5 digit bitmaps
-static const bool digits[10][5][6] = {
-    // 0
-    {
-        {1,1,1,1,1,1},
-        {1,1,0,0,1,1},
-        {1,1,0,0,1,1},
-        {1,1,0,0,1,1},
-        {1,1,1,1,1,1}
-    },
-    // 1
-    {
-        {0,0,1,1,0,0},
-        {0,0,1,1,0,0},
-        {0,0,1,1,0,0},
-        {0,0,1,1,0,0},
-        {0,0,1,1,0,0}
-    },
-    // 2
-    {
-        {1,1,1,1,1,1},
-        {0,0,0,0,1,1},
-        {0,0,1,1,0,0},
-        {1,1,0,0,0,0},
-        {1,1,1,1,1,1}
-    },
-    // 3
-    {
-        {1,1,1,1,1,1},
-        {0,0,0,0,1,1},
-        {1,1,1,1,1,1},
-        {0,0,0,0,1,1},
-        {1,1,1,1,1,1}
-    },
-    // 4
-    {
-        {1,1,0,0,1,1},
-        {1,1,0,0,1,1},
-        {1,1,1,1,1,1},
-        {0,0,0,0,1,1},
-        {0,0,0,0,1,1}
-    },
-    // 5
-    {
-        {1,1,1,1,1,1},
-        {1,1,0,0,0,0},
-        {1,1,1,1,1,1},
-        {0,0,0,0,1,1},
-        {1,1,1,1,1,1}
-    },
-    // 6
-    {
-        {1,1,1,1,1,1},
-        {1,1,0,0,0,0},
-        {1,1,1,1,1,1},
-        {1,1,0,0,1,1},
-        {1,1,1,1,1,1}
-    },
-    // 7
-    {
-        {1,1,1,1,1,1},
-        {0,0,0,0,1,1},
-        {0,0,0,0,1,1},
-        {0,0,0,0,1,1},
-        {0,0,0,0,1,1}
-    },
-    // 8
-    {
-        {1,1,1,1,1,1},
-        {1,1,0,0,1,1},
-        {1,1,1,1,1,1},
-        {1,1,0,0,1,1},
-        {1,1,1,1,1,1}
-    },
-    // 9
-    {
-        {1,1,1,1,1,1},
-        {1,1,0,0,1,1},
-        {1,1,1,1,1,1},
-        {0,0,0,0,1,1},
-        {1,1,1,1,1,1}
-    }
+// Glyphs are 5 rows high, each row packed into one byte with bit 7 as the leftmost column
+static constexpr uint8_t GLYPH_HEIGHT = 5;
+
+struct Glyph {
+    uint8_t rows[GLYPH_HEIGHT];
 };
 
-static inline void get_number_pattern(int *number, uint32_t (*buffer)[256], uint32_t *color) {
-    // memset(buffer, 0, 256 * sizeof(uint32_t));
-    
-    if (*number < 0) *number = 0;
-    if (*number > 99) *number = 99;
-    
-    int left_digit = *number / 10;
-    int right_digit = *number % 10;
-    
-    // Pattern layout:
-    // Rows 0-2: Empty
-    // Rows 3-12: Digits (10 rows)
-    // Rows 13-15: Empty
-    // Cols: 0 (pad), 1-6 (left), 7-8 (pad), 9-14 (right), 15 (pad)
-    
-    for (int row = 0; row < 5; row++) {
-        // Each row in font is mapped to 2 rows in buffer (vertical scaling)
-        int buf_row_a = 6 + row * 2;
-        int buf_row_b = 6 + row * 2 + 1;
-        int row_offset_a = buf_row_a * 16;
-        int row_offset_b = buf_row_b * 16;
-        
-        // Left Digit
-        for (int col = 0; col < 6; col++) {
-            uint32_t val = digits[left_digit][row][col] ? *color : 0;
-            (*buffer)[row_offset_a + 1 + col] = val;
-            (*buffer)[row_offset_b + 1 + col] = val;
-        }
-        
-        // Right Digit
-        for (int col = 0; col < 6; col++) {
-            uint32_t val = digits[right_digit][row][col] ? *color : 0;
-            (*buffer)[row_offset_a + 9 + col] = val;
-            (*buffer)[row_offset_b + 9 + col] = val;
+struct GlyphFont {
+    const Glyph* glyphs;
+    char first;         // character of glyphs[0]
+    char last;
+    uint8_t width;      // columns per glyph, including spacing
+};
+
+// Packs glyph art at compile time: '#' is a lit pixel, '.' a dark one and a space starts the next row
+constexpr Glyph pack_glyph(const char* art) {
+    Glyph glyph = {};
+    uint8_t row = 0;
+    uint8_t col = 0;
+    for (; *art != '\0'; art++) {
+        if (*art == ' ') {
+            row++;
+            col = 0;
+            continue;
         }
+        if (*art == '#') glyph.rows[row] |= 0x80 >> col;
+        col++;
     }
+    return glyph;
 }
 
+// Bold 6x5 digits for numbers
+static constexpr Glyph DIGIT_GLYPHS[10] = {
+    pack_glyph("###### ##..## ##..## ##..## ######"),   // 0
+    pack_glyph("..##.. ..##.. ..##.. ..##.. ..##.."),   // 1
+    pack_glyph("###### ....## ..##.. ##.... ######"),   // 2
+    pack_glyph("###### ....## ###### ....## ######"),   // 3
+    pack_glyph("##..## ##..## ###### ....## ....##"),   // 4
+    pack_glyph("###### ##.... ###### ....## ######"),   // 5
+    pack_glyph("###### ##.... ###### ##..## ######"),   // 6
+    pack_glyph("###### ....## ....## ....## ....##"),   // 7
+    pack_glyph("###### ##..## ###### ##..## ######"),   // 8
+    pack_glyph("###### ##..## ###### ....## ######"),   // 9
+};
 
-
-static const bool font[26][5][4] = {
-    // a
-    {
-        {0,1,0,0},
-        {1,0,1,0},
-        {1,1,1,0},
-        {1,0,1,0},
-        {1,0,1,0}
-    },
-    // b
-    {
-        {1,1,0,0},
-        {1,0,1,0},
-        {1,1,0,0},
-        {1,0,1,0},
-        {1,1,0,0}
-    },
-    // c
-    {
-        {0,1,1,0},
-        {1,0,0,0},
-        {1,0,0,0},
-        {1,0,0,0},
-        {0,1,1,0}
-    },
-    // d
-    {
-        {1,1,0,0},
-        {1,0,1,0},
-        {1,0,1,0},
-        {1,0,1,0},
-        {1,1,0,0}
-    },
-    // e
-    {
-        {1,1,1,0},
-        {1,0,0,0},
-        {1,1,1,0},
-        {1,0,0,0},
-        {1,1,1,0}
-    },
-    // f
-    {
-        {1,1,1,0},
-        {1,0,0,0},
-        {1,1,1,0},
-        {1,0,0,0},
-        {1,0,0,0}
-    },
-    // g
-    {
-        {0,1,1,0},
-        {1,0,0,0},
-        {1,0,1,0},
-        {1,0,1,0},
-        {0,1,1,0}
-    },
-    // h
-    {
-        {1,0,1,0},
-        {1,0,1,0},
-        {1,1,1,0},
-        {1,0,1,0},
-        {1,0,1,0}
-    },
-    // i
-    {
-        {0,1,0,0},
-        {0,1,0,0},
-        {0,1,0,0},
-        {0,1,0,0},
-        {0,1,0,0}
-    },
-    // j
-    {
-        {0,0,1,0},
-        {0,0,1,0},
-        {0,0,1,0},
-        {1,0,1,0},
-        {0,1,1,0}
-    },
-    // k
-    {
-        {1,0,1,0},
-        {1,0,1,0},
-        {1,1,0,0},
-        {1,0,1,0},
-        {1,0,1,0}
-    },
-    // l
-    {
-        {1,0,0,0},
-        {1,0,0,0},
-        {1,0,0,0},
-        {1,0,0,0},
-        {1,1,1,0}
-    },
-    // m
-    {
-        {1,0,1,0},
-        {1,1,1,0},
-        {1,0,1,0},
-        {1,0,1,0},
-        {1,0,1,0}
-    },
-    // n
-    {
-        {1,1,1,0},
-        {1,0,1,0},
-        {1,0,1,0},
-        {1,0,1,0},
-        {1,0,1,0}
-    },
-    // o
-    {
-        {0,1,0,0},
-        {1,0,1,0},
-        {1,0,1,0},
-        {1,0,1,0},
-        {0,1,0,0}
-    },
-    // p
-    {
-        {1,1,0,0},
-        {1,0,1,0},
-        {1,1,0,0},
-        {1,0,0,0},
-        {1,0,0,0}
-    },
-    // q
-    {
-        {0,1,0,0},
-        {1,0,1,0},
-        {1,0,1,0},
-        {0,1,1,0},
-        {0,0,1,0}
-    },
-    // r
-    {
-        {1,1,0,0},
-        {1,0,1,0},
-        {1,1,0,0},
-        {1,1,0,0},
-        {1,0,1,0}
-    },
-    // s
-    {
-        {0,1,1,0},
-        {1,0,0,0},
-        {0,1,0,0},
-        {0,0,1,0},
-        {1,1,0,0}
-    },
-    // t
-    {
-        {1,1,1,0},
-        {0,1,0,0},
-        {0,1,0,0},
-        {0,1,0,0},
-        {0,1,0,0}
-    },
-    // u
-    {
-        {1,0,1,0},
-        {1,0,1,0},
-        {1,0,1,0},
-        {1,0,1,0},
-        {1,1,1,0}
-    },
-    // v
-    {
-        {1,0,1,0},
-        {1,0,1,0},
-        {1,0,1,0},
-        {1,0,1,0},
-        {0,1,0,0}
-    },
-    // w
-    {
-        {1,0,1,0},
-        {1,0,1,0},
-        {1,0,1,0},
-        {1,1,1,0},
-        {1,0,1,0}
-    },
-    // x
-    {
-        {1,0,1,0},
-        {0,1,0,0},
-        {0,1,0,0},
-        {0,1,0,0},
-        {1,0,1,0}
-    },
-    // y
-    {
-        {1,0,1,0},
-        {1,0,1,0},
-        {0,1,0,0},
-        {0,1,0,0},
-        {0,1,0,0}
-    },
-    // z
-    {
-        {1,1,1,0},
-        {0,0,1,0},
-        {0,1,0,0},
-        {1,0,0,0},
-        {1,1,1,0}
-    }
+// 3x5 printable ASCII plus a spacing column, lower case shares the upper case glyphs
+static constexpr Glyph TEXT_GLYPHS[95] = {
+    pack_glyph(".... .... .... .... ...."),   // ' '
+    pack_glyph(".#.. .#.. .#.. .... .#.."),   // '!'
+    pack_glyph("#.#. #.#. .... .... ...."),   // '"'
+    pack_glyph("#.#. ###. #.#. ###. #.#."),   // '#'
+    pack_glyph(".##. ##.. .#.. .##. ##.."),   // '$'
+    pack_glyph("#... ..#. .#.. #... ..#."),   // '%'
+    pack_glyph(".#.. #.#. .#.. #.#. .##."),   // '&'
+    pack_glyph(".#.. .#.. .... .... ...."),   // '\''
+    pack_glyph("..#. .#.. .#.. .#.. ..#."),   // '('
+    pack_glyph("#... .#.. .#.. .#.. #..."),   // ')'
+    pack_glyph(".... #.#. .#.. #.#. ...."),   // '*'
+    pack_glyph(".... .#.. ###. .#.. ...."),   // '+'
+    pack_glyph(".... .... .... .#.. #..."),   // ','
+    pack_glyph(".... .... ###. .... ...."),   // '-'
+    pack_glyph(".... .... .... .... .#.."),   // '.'
+    pack_glyph("..#. ..#. .#.. #... #..."),   // '/'
+    pack_glyph("###. #.#. #.#. #.#. ###."),   // '0'
+    pack_glyph(".#.. ##.. .#.. .#.. ###."),   // '1'
+    pack_glyph("###. ..#. ###. #... ###."),   // '2'
+    pack_glyph("###. ..#. .##. ..#. ###."),   // '3'
+    pack_glyph("#.#. #.#. ###. ..#. ..#."),   // '4'
+    pack_glyph("###. #... ###. ..#. ###."),   // '5'
+    pack_glyph("###. #... ###. #.#. ###."),   // '6'
+    pack_glyph("###. ..#. ..#. .#.. .#.."),   // '7'
+    pack_glyph("###. #.#. ###. #.#. ###."),   // '8'
+    pack_glyph("###. #.#. ###. ..#. ###."),   // '9'
+    pack_glyph(".... .#.. .... .#.. ...."),   // ':'
+    pack_glyph(".... .#.. .... .#.. #..."),   // ';'
+    pack_glyph("..#. .#.. #... .#.. ..#."),   // '<'
+    pack_glyph(".... ###. .... ###. ...."),   // '='
+    pack_glyph("#... .#.. ..#. .#.. #..."),   // '>'
+    pack_glyph("###. ..#. .#.. .... .#.."),   // '?'
+    pack_glyph(".#.. #.#. ###. #... .##."),   // '@'
+    pack_glyph(".#.. #.#. ###. #.#. #.#."),   // 'A'
+    pack_glyph("##.. #.#. ##.. #.#. ##.."),   // 'B'
+    pack_glyph(".##. #... #... #... .##."),   // 'C'
+    pack_glyph("##.. #.#. #.#. #.#. ##.."),   // 'D'
+    pack_glyph("###. #... ###. #... ###."),   // 'E'
+    pack_glyph("###. #... ###. #... #..."),   // 'F'
+    pack_glyph(".##. #... #.#. #.#. .##."),   // 'G'
+    pack_glyph("#.#. #.#. ###. #.#. #.#."),   // 'H'
+    pack_glyph(".#.. .#.. .#.. .#.. .#.."),   // 'I'
+    pack_glyph("..#. ..#. ..#. #.#. .##."),   // 'J'
+    pack_glyph("#.#. #.#. ##.. #.#. #.#."),   // 'K'
+    pack_glyph("#... #... #... #... ###."),   // 'L'
+    pack_glyph("#.#. ###. #.#. #.#. #.#."),   // 'M'
+    pack_glyph("###. #.#. #.#. #.#. #.#."),   // 'N'
+    pack_glyph(".#.. #.#. #.#. #.#. .#.."),   // 'O'
+    pack_glyph("##.. #.#. ##.. #... #..."),   // 'P'
+    pack_glyph(".#.. #.#. #.#. .##. ..#."),   // 'Q'
+    pack_glyph("##.. #.#. ##.. ##.. #.#."),   // 'R'
+    pack_glyph(".##. #... .#.. ..#. ##.."),   // 'S'
+    pack_glyph("###. .#.. .#.. .#.. .#.."),   // 'T'
+    pack_glyph("#.#. #.#. #.#. #.#. ###."),   // 'U'
+    pack_glyph("#.#. #.#. #.#. #.#. .#.."),   // 'V'
+    pack_glyph("#.#. #.#. #.#. ###. #.#."),   // 'W'
+    pack_glyph("#.#. .#.. .#.. .#.. #.#."),   // 'X'
+    pack_glyph("#.#. #.#. .#.. .#.. .#.."),   // 'Y'
+    pack_glyph("###. ..#. .#.. #... ###."),   // 'Z'
+    pack_glyph("##.. #... #... #... ##.."),   // '['
+    pack_glyph("#... #... .#.. ..#. ..#."),   // '\\'
+    pack_glyph(".##. ..#. ..#. ..#. .##."),   // ']'
+    pack_glyph(".#.. #.#. .... .... ...."),   // '^'
+    pack_glyph(".... .... .... .... ###."),   // '_'
+    pack_glyph("#... .#.. .... .... ...."),   // '`'
+    pack_glyph(".#.. #.#. ###. #.#. #.#."),   // 'a'
+    pack_glyph("##.. #.#. ##.. #.#. ##.."),   // 'b'
+    pack_glyph(".##. #... #... #... .##."),   // 'c'
+    pack_glyph("##.. #.#. #.#. #.#. ##.."),   // 'd'
+    pack_glyph("###. #... ###. #... ###."),   // 'e'
+    pack_glyph("###. #... ###. #... #..."),   // 'f'
+    pack_glyph(".##. #... #.#. #.#. .##."),   // 'g'
+    pack_glyph("#.#. #.#. ###. #.#. #.#."),   // 'h'
+    pack_glyph(".#.. .#.. .#.. .#.. .#.."),   // 'i'
+    pack_glyph("..#. ..#. ..#. #.#. .##."),   // 'j'
+    pack_glyph("#.#. #.#. ##.. #.#. #.#."),   // 'k'
+    pack_glyph("#... #... #... #... ###."),   // 'l'
+    pack_glyph("#.#. ###. #.#. #.#. #.#."),   // 'm'
+    pack_glyph("###. #.#. #.#. #.#. #.#."),   // 'n'
+    pack_glyph(".#.. #.#. #.#. #.#. .#.."),   // 'o'
+    pack_glyph("##.. #.#. ##.. #... #..."),   // 'p'
+    pack_glyph(".#.. #.#. #.#. .##. ..#."),   // 'q'
+    pack_glyph("##.. #.#. ##.. ##.. #.#."),   // 'r'
+    pack_glyph(".##. #... .#.. ..#. ##.."),   // 's'
+    pack_glyph("###. .#.. .#.. .#.. .#.."),   // 't'
+    pack_glyph("#.#. #.#. #.#. #.#. ###."),   // 'u'
+    pack_glyph("#.#. #.#. #.#. #.#. .#.."),   // 'v'
+    pack_glyph("#.#. #.#. #.#. ###. #.#."),   // 'w'
+    pack_glyph("#.#. .#.. .#.. .#.. #.#."),   // 'x'
+    pack_glyph("#.#. #.#. .#.. .#.. .#.."),   // 'y'
+    pack_glyph("###. ..#. .#.. #... ###."),   // 'z'
+    pack_glyph("..#. .#.. ##.. .#.. ..#."),   // '{'
+    pack_glyph(".#.. .#.. .#.. .#.. .#.."),   // '|'
+    pack_glyph("#... .#.. .##. .#.. #..."),   // '}'
+    pack_glyph(".... .##. ##.. .... ...."),   // '~'
 };
 
-static inline void get_label_pattern(const char (*text)[4], uint32_t (*buffer)[256], uint32_t *color) {
-    for (int pos = 0; pos < 4; pos++) {
-        char c = (*text)[pos];
-        if (c == '\0') c = ' '; // Fallback if string is short
-        
-        if (c >= 'A' && c <= 'Z') c = c - 'A' + 'a';
-        // if (c < 'a' || c > 'z') c = 'a';
-        if (c < 'a' || c > 'z') continue;
-        int idx = c - 'a';
+static constexpr GlyphFont DIGIT_FONT = { DIGIT_GLYPHS, '0', '9', 6 };
+static constexpr GlyphFont TEXT_FONT = { TEXT_GLYPHS, ' ', '~', 4 };
 
-        for (int row = 0; row < 5; row++) {
-            for (int col = 0; col < 4; col++) {
-                (*buffer)[row * 16 + pos * 4 + col] = font[idx][row][col] ? *color : 0;
+static constexpr Glyph BLANK_GLYPH = {};
+
+static inline const Glyph& font_glyph(const GlyphFont& font, char c) {
+    if (c < font.first || c > font.last) return BLANK_GLYPH;
+    return font.glyphs[c - font.first];
+}
+
+/**
+ * @brief Draw a glyph into a 16x16 buffer one row at a time
+ *
+ * Every glyph pixel becomes a scale_x by scale_y block. Dark pixels clear the buffer, so a glyph
+ * replaces what was below it. Everything outside the buffer is clipped, x and y may be negative.
+ */
+static inline void blit_glyph(uint32_t (*buffer)[256], const GlyphFont& font, char c, int x, int y,
+    uint32_t color, uint8_t scale_x = 1, uint8_t scale_y = 1) {
+    const Glyph& glyph = font_glyph(font, c);
+    int left = x < 0 ? 0 : x;
+    int right = x + font.width * scale_x;
+    if (right > 16) right = 16;
+    if (left >= right) return;
+
+    for (int row = 0; row < GLYPH_HEIGHT; row++) {
+        // Expand the packed row once, then repeat it for the vertical scale
+        uint32_t span[16];
+        uint8_t bits = glyph.rows[row];
+        for (int bx = left; bx < right; bx++) {
+            int col = (bx - x) / scale_x;
+            span[bx] = (bits & (0x80 >> col)) ? color : 0;
+        }
+        for (int sy = 0; sy < scale_y; sy++) {
+            int by = y + row * scale_y + sy;
+            if (by < 0 || by >= 16) continue;
+            uint32_t* line = &(*buffer)[by * 16];
+            for (int bx = left; bx < right; bx++) {
+                line[bx] = span[bx];
             }
         }
     }
 }
 
+// Draw text from (x, y) on, returns the column after the last glyph (also when clipped)
+static inline int blit_text(uint32_t (*buffer)[256], const GlyphFont& font, const char* text, int x, int y,
+    uint32_t color, uint8_t scale_x = 1, uint8_t scale_y = 1) {
+    for (; *text != '\0'; text++) {
+        if (x >= 16) {
+            x += font.width * scale_x;
+            continue;
+        }
+        blit_glyph(buffer, font, *text, x, y, color, scale_x, scale_y);
+        x += font.width * scale_x;
+    }
+    return x;
+}
+
+static inline void get_number_pattern(int *number, uint32_t (*buffer)[256], uint32_t *color) {
+    if (*number < 0) *number = 0;
+    if (*number > 99) *number = 99;
+
+    // Pattern layout:
+    // Rows 6-15: Digits (5 font rows doubled)
+    // Cols: 0 (pad), 1-6 (left), 7-8 (pad), 9-14 (right), 15 (pad)
+    blit_glyph(buffer, DIGIT_FONT, '0' + *number / 10, 1, 6, *color, 1, 2);
+    blit_glyph(buffer, DIGIT_FONT, '0' + *number % 10, 9, 6, *color, 1, 2);
+}
+
+static inline void get_label_pattern(const char (*text)[4], uint32_t (*buffer)[256], uint32_t *color) {
+    // Rows 0-4, four glyphs of four columns
+    for (int pos = 0; pos < 4 && (*text)[pos] != '\0'; pos++) {
+        blit_glyph(buffer, TEXT_FONT, (*text)[pos], pos * 4, 0, *color);
+    }
+}
+
 static inline void get_note_pattern(const char (*note_str)[3], uint32_t (*buffer)[256], uint32_t *color) {
-    // Clear only rows 6-15 (10 rows * 16 columns)
-    // memset(&(*buffer)[6 * 16], 0, 10 * 16 * sizeof(uint32_t));
-    
     // Layout strategy:
     // Rows 6-15 (10 rows height).
     // Col 0: Flat Dot.
@@ -365,62 +229,30 @@ static inline void get_note_pattern(const char (*note_str)[3], uint32_t (*buffer
     // Cols 9-14: Octave (0-9), using full 10x6 digits font.
     // Col 15: Sharp Dot.
 
-    int start_row = 6; 
+    int start_row = 6;
 
     // 1. Note (A-G) -> Cols 1-8
     char note = (*note_str)[0];
-    if (note >= 'A' && note <= 'Z') note = note - 'A' + 'a';
-    if (note >= 'a' && note <= 'z') {
-         int idx = note - 'a';
-         for (int row = 0; row < 5; row++) {
-             // Scale 5-row font to 10 rows (2x vertical)
-             int buf_row_a = start_row + row * 2;
-             int buf_row_b = start_row + row * 2 + 1;
-             
-             for (int col = 0; col < 4; col++) {
-                 // Scale 4-col font to 8 cols (2x horizontal)
-                 // Start at Col 1
-                 int buf_col_a = 1 + col * 2;
-                 int buf_col_b = 1 + col * 2 + 1;
-                 
-                 uint32_t val = font[idx][row][col] ? *color : 0;
-                 
-                 // Fill 2x2 block
-                 (*buffer)[buf_row_a * 16 + buf_col_a] = val;
-                 (*buffer)[buf_row_a * 16 + buf_col_b] = val;
-                 (*buffer)[buf_row_b * 16 + buf_col_a] = val;
-                 (*buffer)[buf_row_b * 16 + buf_col_b] = val;
-             }
-         }
+    if ((note >= 'A' && note <= 'Z') || (note >= 'a' && note <= 'z')) {
+        blit_glyph(buffer, TEXT_FONT, note, 1, start_row, *color, 2, 2);
     }
 
     // 2. Octave (0-9) -> Cols 9-14
     char octave = (*note_str)[1];
     if (octave >= '0' && octave <= '9') {
-        int idx = octave - '0';
-        for (int row = 0; row < 5; row++) {
-             int buf_row_a = start_row + row * 2;
-             int buf_row_b = start_row + row * 2 + 1;
-            for (int col = 0; col < 6; col++) {
-                // Right digit starts at col 9
-                uint32_t val = digits[idx][row][col] ? *color : 0;
-                (*buffer)[buf_row_a * 16 + 9 + col] = val;
-                (*buffer)[buf_row_b * 16 + 9 + col] = val;
-            }
-        }
+        blit_glyph(buffer, DIGIT_FONT, octave, 9, start_row, *color, 1, 2);
     }
 
     // 3. Modifier (sharp/flat) -> Outer Columns (0 or 15)
     char mod = (*note_str)[2];
     bool is_sharp = (mod == '#' || mod == 's' || mod == 'S');
     bool is_flat = (mod == 'b' || mod == 'f' || mod == 'F');
-    
+
     if (is_sharp) {
         // Sharp: Outer Right (Col 15), Top (rows 6-7)
         int col = 15;
         (*buffer)[(start_row + 0) * 16 + col] = *color;
         (*buffer)[(start_row + 1) * 16 + col] = 0;
-        // Make it a bit taller/substantial? 2 pixels high is fine for a dot.
     } else if (is_flat) {
         // Flat: Outer Left (Col 0), Bottom (rows 14-15)
         int col = 0;
@@ -428,4 +260,3 @@ static inline void get_note_pattern(const char (*note_str)[3], uint32_t (*buffer
         (*buffer)[(start_row + 9) * 16 + col] = *color;
     }
 }
-
@@ -1,5 +1,6 @@
 // #include <stdio.h>
 #include <string.h>
+#include "pico/assert.h"
 #include "pico/sem.h"
 #include "hardware/pio.h"
 #include "hardware/dma.h"
@@ -9,16 +10,8 @@
 
 #define NUM_PIXELS 256
 
-// DMA channels
-#define DMA_CHANNEL 0
-#define DMA_CB_CHANNEL 1
-#define DMA_CHANNEL_MASK (1u << DMA_CHANNEL)
-#define DMA_CB_CHANNEL_MASK (1u << DMA_CB_CHANNEL)
-#define DMA_CHANNELS_MASK (DMA_CHANNEL_MASK | DMA_CB_CHANNEL_MASK)
-
-// Driver state
-static uint32_t led_data[NUM_PIXELS];
-static uint led_index;
+// Driver state, the frame itself is owned by the caller
+static uint dma_channel;
 static struct semaphore reset_delay_complete_sem;
 static alarm_id_t reset_delay_alarm_id;
 static PIO ws2812_pio;
@@ -34,24 +27,26 @@ static int64_t reset_delay_complete(__unused alarm_id_t id, __unused void *user_
 
 // DMA complete interrupt handler
 static void __isr dma_complete_handler() {
-    if (dma_hw->ints0 & DMA_CHANNEL_MASK) {
-        dma_hw->ints0 = DMA_CHANNEL_MASK;
+    uint32_t channel_mask = 1u << dma_channel;
+    if (dma_hw->ints0 & channel_mask) {
+        dma_hw->ints0 = channel_mask;
         if (reset_delay_alarm_id) cancel_alarm(reset_delay_alarm_id);
         reset_delay_alarm_id = add_alarm_in_us(400, reset_delay_complete, NULL, true);
     }
 }
 
 static void dma_setup_init(PIO pio, uint sm) {
-    dma_claim_mask(DMA_CHANNELS_MASK);
+    // Any free channel, so other drivers using DMA can be set up before or after this one
+    dma_channel = (uint)dma_claim_unused_channel(true);
 
-    dma_channel_config channel_config = dma_channel_get_default_config(DMA_CHANNEL);
+    dma_channel_config channel_config = dma_channel_get_default_config(dma_channel);
     channel_config_set_transfer_data_size(&channel_config, DMA_SIZE_32);
     channel_config_set_dreq(&channel_config, pio_get_dreq(pio, sm, true));
     channel_config_set_irq_quiet(&channel_config, false);
-    dma_channel_configure(DMA_CHANNEL, &channel_config, &pio->txf[sm], led_data, NUM_PIXELS, false);
+    dma_channel_configure(dma_channel, &channel_config, &pio->txf[sm], NULL, NUM_PIXELS, false);
 
     irq_set_exclusive_handler(DMA_IRQ_0, dma_complete_handler);
-    dma_channel_set_irq0_enabled(DMA_CHANNEL, true);
+    dma_channel_set_irq0_enabled(dma_channel, true);
     irq_set_enabled(DMA_IRQ_0, true);
 }
 
@@ -68,30 +63,10 @@ void ws2812_dma_init(uint pin) {
     dma_setup_init(ws2812_pio, ws2812_sm);
 }
 
-void ws2812_put_pixel(uint32_t pixel_grb) {
-    led_data[led_index++] = pixel_grb << 8u;
-}
-
-void ws2812_put_pixels(uint32_t *pixels) {
-    for (uint i = 0; i < NUM_PIXELS; i++) {
-        led_data[i] = pixels[i] << 8u;
-    }
-}
-
-void ws2812_reset_pixel_index(void) {
-    led_index = 0;
-}
-
-void ws2812_dma_trigger(void) {
-    dma_channel_set_read_addr(DMA_CHANNEL, led_data, true);
+void ws2812_dma_transfer(const uint32_t *frame) {
+    dma_channel_set_read_addr(dma_channel, frame, true);
 }
 
 bool ws2812_dma_ready(void) {
     return sem_try_acquire(&reset_delay_complete_sem);
-}
-
-void ws2812_dma_handle(void) {
-    if (ws2812_dma_ready()) {
-        ws2812_dma_trigger();
-    }
 }
\ No newline at end of file
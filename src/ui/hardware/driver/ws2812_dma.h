@@ -2,7 +2,6 @@
 #define WS2812_DMA_H
 
 #include <pico/types.h>
-#include "pico/assert.h"
 
 #define NUM_PIXELS 256
 
@@ -18,16 +17,9 @@ static inline uint32_t urgb_u32(uint8_t r, uint8_t g, uint8_t b) {
             (uint32_t) (b);
 }
 
-// Helper to create 32-bit GRB color with brightness (0-255)
-static inline uint32_t urgb_u32_dimmed(uint8_t r, uint8_t g, uint8_t b, uint8_t brightness) {
-    hard_assert(brightness <= 255 && brightness >= 0);
-    // Scale each channel by the brightness factor
-    // (val * brightness) >> 8 is equivalent to (val * brightness) / 256
-    return urgb_u32(
-        (uint8_t)((uint16_t)r * brightness >> 8),
-        (uint8_t)((uint16_t)g * brightness >> 8),
-        (uint8_t)((uint16_t)b * brightness >> 8)
-    );
+// The PIO program shifts pixels out MSB first, 24 bits per LED
+static inline uint32_t ws2812_wire(uint32_t pixel_grb) {
+    return pixel_grb << 8u;
 }
 
 /**
@@ -38,47 +30,26 @@ static inline uint32_t urgb_u32_dimmed(uint8_t r, uint8_t g, uint8_t b, uint8_t
 void ws2812_dma_init(uint pin);
 
 /**
- * @brief Add a pixel to the internal buffer
+ * @brief Start a DMA transfer of a whole frame to the LEDs
  * 
- * @param pixel_grb The 32-bit GRB color value
- */
-void ws2812_put_pixel(uint32_t pixel_grb);
-
-/**
- * @brief  Replace the content of the internal buffer with the given array
+ * The frame is sent in place, without a copy, so it must hold <NUM_PIXELS> GRB values already
+ * shifted into the top 24 bits (see ws2812_wire()) and must not change until the next
+ * successful ws2812_dma_ready(). Only call this after ws2812_dma_ready() returned true.
  * 
- * @param pixels Array of <NUM_PIXELS> 32-bit GRB color values
- */
-void ws2812_put_pixels(uint32_t *pixels);
-
-/**
- * @brief Reset the internal pixel index to 0
+ * @param frame Array of <NUM_PIXELS> pre-shifted pixels
  */
-void ws2812_reset_pixel_index(void);
-
-/**
- * @brief Trigger a DMA transfer to update the LEDs
- * 
- * This function initiates the transfer of the buffer to the PIO via DMA.
- * It does not block. Use ws2812_dma_ready() to check if the next transfer can start.
- */
-void ws2812_dma_trigger(void);
+void ws2812_dma_transfer(const uint32_t *frame);
 
 /**
  * @brief Check if the driver is ready for a new transfer
  * 
+ * A true result claims the driver, it must be followed by ws2812_dma_transfer().
+ * 
  * @return true if the previous transfer (plus reset delay) is complete
  * @return false if the driver is busy
  */
 bool ws2812_dma_ready(void);
 
-/**
- * @brief Handle DMA transfer (trigger if ready)
- * 
- * Checks if the DMA is ready and triggers a new transfer if so.
- */
-void ws2812_dma_handle(void);
-
 #ifdef __cplusplus
 }
 #endif
@@ -6,7 +6,7 @@
 namespace ui::state {
 
 void setBpm(UIState& state, int bpm) {
-    state.bpm = std::max(40, std::min(255, bpm));
+    state.bpm = std::max(40, std::min(300, bpm));
     commands::sendCommand(commands::Command::BPM_SET, state.bpm);
 }
 
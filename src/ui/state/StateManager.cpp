@@ -1,20 +1,64 @@
 #include "StateManager.h"
 #include "Reducer.h"
+#include "../../common/log.h"
 
 namespace ui::state {
 
-StateManager::StateManager() {}
+StateManager::StateManager() : subscriberCount(0), queueHead(0), queueTail(0) {}
 
 void StateManager::dispatch(const events::Event& event) {
-    UIState newState = reduce(currentState, event);
-    currentState = newState;
-    if (listener_) {
-        listener_(currentState);
+    UIState before = currentState;
+    currentState = reduce(currentState, event);
+    notify(before);
+}
+
+void StateManager::post(const events::Event& event) {
+    uint8_t used = static_cast<uint8_t>(queueHead - queueTail);
+    if (event.type == events::EventType::POT_CHANGED && used > 0) {
+        // Only the newest reading of a pot matters
+        events::Event& newest = queue[static_cast<uint8_t>(queueHead - 1) & EVENT_MASK];
+        if (newest.type == events::EventType::POT_CHANGED && newest.data.pot.id == event.data.pot.id) {
+            newest = event;
+            return;
+        }
+    }
+    if (used >= EVENT_CAPACITY) {
+        LOG_WARN("StateManager::post: event queue full, dropping event type %d\n", event.type);
+        return;
+    }
+    queue[queueHead & EVENT_MASK] = event;
+    queueHead++;
+}
+
+uint8_t StateManager::processEvents() {
+    UIState before = currentState;
+    uint8_t count = 0;
+    while (queueTail != queueHead) {
+        currentState = reduce(currentState, queue[queueTail & EVENT_MASK]);
+        queueTail++;
+        count++;
+    }
+    if (count > 0) {
+        notify(before);
     }
+    return count;
 }
 
-void StateManager::subscribe(StateChangeListener listener) {
-    listener_ = listener;
+bool StateManager::subscribe(StateChangeListener listener, void* context, StateFieldMask fields) {
+    if (subscriberCount >= MAX_SUBSCRIBERS) return false;
+    subscribers[subscriberCount++] = { listener, context, fields };
+    return true;
+}
+
+void StateManager::notify(const UIState& before) {
+    StateFieldMask changed = changedFields(before, currentState);
+    if (changed == 0) return;
+    for (uint8_t i = 0; i < subscriberCount; i++) {
+        const Subscriber& subscriber = subscribers[i];
+        if (subscriber.fields & changed) {
+            subscriber.listener(currentState, changed, subscriber.context);
+        }
+    }
 }
 
 StateManager& getStateManager() {
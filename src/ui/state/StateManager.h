@@ -2,25 +2,69 @@
 
 #include "UIState.h"
 #include "../Event.h"
-#include <functional>
+#include <cstdint>
 
 namespace ui::state {
 
 class StateManager {
 public:
+    static constexpr uint8_t EVENT_CAPACITY = 32;   // must be a power of two
+    static constexpr uint8_t MAX_SUBSCRIBERS = 4;
+
     StateManager();
     ~StateManager() = default;
     
     const UIState& getState() const { return currentState; }
     
+    // Reduce an event and notify the interested subscribers right away
     void dispatch(const events::Event& event);
+
+    // Queue an event from a driver scan. A POT_CHANGED for the pot of the newest queued event
+    // replaces its value instead of taking another entry. Drops the event if the queue is full.
+    void post(const events::Event& event);
+
+    /**
+     * @brief Reduce all queued events and notify the interested subscribers once
+     *
+     * Called once per UIController::update, so views render at most once per pass however many
+     * events came in.
+     *
+     * @return Number of events reduced
+     */
+    uint8_t processEvents();
     
-    using StateChangeListener = std::function<void(const UIState& newState)>;
-    void subscribe(StateChangeListener listener);
+    // changed holds the fields that differ from the state before the dispatch
+    using StateChangeListener = void (*)(const UIState& newState, StateFieldMask changed, void* context);
+
+    /**
+     * @brief Call listener whenever one of the given fields changed
+     *
+     * Events that leave those fields alone do not call it.
+     *
+     * @return false if all MAX_SUBSCRIBERS entries are taken
+     */
+    bool subscribe(StateChangeListener listener, void* context, StateFieldMask fields);
     
 private:
+    static constexpr uint8_t EVENT_MASK = EVENT_CAPACITY - 1;
+    static_assert((EVENT_CAPACITY & EVENT_MASK) == 0, "EVENT_CAPACITY must be a power of two");
+
+    struct Subscriber {
+        StateChangeListener listener;
+        void* context;
+        StateFieldMask fields;
+    };
+
     UIState currentState;
-    StateChangeListener listener_;
+    Subscriber subscribers[MAX_SUBSCRIBERS];
+    uint8_t subscriberCount;
+
+    // Drivers and the drain both run in the UI loop on core 0, so the ring needs no barriers
+    events::Event queue[EVENT_CAPACITY];
+    uint8_t queueHead;      // free running
+    uint8_t queueTail;
+
+    void notify(const UIState& before);
 };
 
 extern StateManager& getStateManager();
@@ -11,11 +11,29 @@ enum class ViewId : uint8_t {
 
 struct UIState {
     ViewId currentView;
-    uint8_t bpm;
+    uint16_t bpm;
     bool playing;
     int value;
     
     UIState() : currentView(ViewId::INIT), bpm(120), playing(false), value(0) {}
 };
 
+// Bit per UIState field, subscribers name the fields they depend on
+using StateFieldMask = uint8_t;
+static constexpr StateFieldMask FIELD_CURRENT_VIEW = 1 << 0;
+static constexpr StateFieldMask FIELD_BPM = 1 << 1;
+static constexpr StateFieldMask FIELD_PLAYING = 1 << 2;
+static constexpr StateFieldMask FIELD_VALUE = 1 << 3;
+static constexpr StateFieldMask FIELD_ALL = 0xFF;
+
+// Fields that differ between two states, a new field needs a bit and a line here
+inline StateFieldMask changedFields(const UIState& before, const UIState& after) {
+    StateFieldMask changed = 0;
+    if (before.currentView != after.currentView) changed |= FIELD_CURRENT_VIEW;
+    if (before.bpm != after.bpm) changed |= FIELD_BPM;
+    if (before.playing != after.playing) changed |= FIELD_PLAYING;
+    if (before.value != after.value) changed |= FIELD_VALUE;
+    return changed;
+}
+
 } // namespace ui::state
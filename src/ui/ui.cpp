@@ -1,6 +1,7 @@
 #include "ui.h"
 #include <cstdio>
 #include "pico/time.h"
+#include "../common/log.h"
 
 namespace ui
 {
@@ -9,13 +10,21 @@ namespace ui
         const uint8_t (&buttonPins)[6],
         uint8_t ledPin,
         uint8_t ledMatrixPin,
-        uint8_t potPin) :
+        uint8_t potPin,
+        i2c_inst_t* lcdI2c,
+        uint8_t lcdAddress,
+        uint8_t lcdSdaPin,
+        uint8_t lcdSclPin) :
         config{
             {buttonPins[0], buttonPins[1], buttonPins[2],
              buttonPins[3], buttonPins[4], buttonPins[5]},
             ledPin,
             ledMatrixPin,
-            potPin
+            potPin,
+            lcdI2c,
+            lcdAddress,
+            lcdSdaPin,
+            lcdSclPin
         }
     {
         controller = std::make_unique<UIController>(config);
@@ -37,7 +46,11 @@ namespace ui
         const uint8_t (&buttonPins)[6],
         uint8_t ledPin,
         uint8_t ledMatrixPin,
-        uint8_t potPin)
+        uint8_t potPin,
+        i2c_inst_t* lcdI2c,
+        uint8_t lcdAddress,
+        uint8_t lcdSdaPin,
+        uint8_t lcdSclPin)
     {
         printf("constructing UI facade\n");
         // Create and initialize UI with pin assignments
@@ -45,7 +58,11 @@ namespace ui
             buttonPins,
             ledPin,
             ledMatrixPin,
-            potPin);
+            potPin,
+            lcdI2c,
+            lcdAddress,
+            lcdSdaPin,
+            lcdSclPin);
         printf("initializing UI facade\n");
         ui.init();
 
@@ -55,6 +72,9 @@ namespace ui
             // Update UI components
             ui.update();
 
+            // Print deferred log records, one per pass so a burst cannot stall the UI
+            common::drainLog(1);
+
             // Small delay to prevent tight looping
             sleep_ms(1);
         }
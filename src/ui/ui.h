@@ -15,7 +15,11 @@ namespace ui
             const uint8_t (&buttonPins)[6],
             uint8_t ledPin,
             uint8_t ledMatrixPin,
-            uint8_t potPin);
+            uint8_t potPin,
+            i2c_inst_t* lcdI2c,
+            uint8_t lcdAddress,
+            uint8_t lcdSdaPin,
+            uint8_t lcdSclPin);
         
         void init();
         void update();
@@ -30,6 +34,10 @@ namespace ui
         const uint8_t (&buttonPins)[6],
         uint8_t ledPin,
         uint8_t ledMatrixPin,
-        uint8_t potPin);
+        uint8_t potPin,
+        i2c_inst_t* lcdI2c,
+        uint8_t lcdAddress,
+        uint8_t lcdSdaPin,
+        uint8_t lcdSclPin);
 
 } // namespace ui
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../state/UIState.h"
+#include "../../commands/telemetry.h"
 
 namespace ui {
 
@@ -11,6 +12,9 @@ public:
     virtual void onEnter() {}
     virtual void onExit() {}
     virtual void render(const state::UIState& state) = 0;
+
+    // Called with the newest sequencer snapshot, at most once per UI update
+    virtual void onTelemetry(const commands::Telemetry& /*telemetry*/) {}
 };
 
 } // namespace ui
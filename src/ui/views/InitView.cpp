@@ -3,15 +3,31 @@
 
 namespace ui {
 
-InitView::InitView(hardware::Led& led, hardware::LedMatrix& ledMatrix) :
+InitView::InitView(hardware::Led& led, hardware::LedMatrix& ledMatrix, hardware::LedCompositor& compositor,
+    hardware::Display& display) :
     led(led),
-    ledMatrix(ledMatrix)
-{}
+    ledMatrix(ledMatrix),
+    compositor(compositor),
+    display(display)
+{
+    for (uint8_t& id : flashIds) {
+        id = hardware::LedCompositor::INVALID_ID;
+    }
+}
 
 void InitView::onEnter()
 {
     printf("Entering Main View\n");
     ledMatrix.clear();
+    // Play and stop swap on every transport change, keep both uploaded
+    display.pinGlyph(LCD_GLYPH_PLAY);
+    display.pinGlyph(LCD_GLYPH_STOP);
+}
+
+void InitView::onExit()
+{
+    display.pinGlyph(LCD_GLYPH_PLAY, false);
+    display.pinGlyph(LCD_GLYPH_STOP, false);
 }
 
 void InitView::render(const state::UIState& state)
@@ -23,9 +39,55 @@ void InitView::render(const state::UIState& state)
         led.off();
     }
 
-    ledMatrix.drawNumber(state.value, 0xFFFF0011);
-    ledMatrix.drawLabel("tst", 0x0000FF33);
+    ledMatrix.drawNumber(state.value, 0xFFFF004A);
+    ledMatrix.drawLabel("tst", 0x0000FF7B);
+
+    // Only the changed cells reach the LCD, see Display
+    uint16_t value = state.value > 0 ? static_cast<uint16_t>(state.value) : 0;
+    char text[hardware::Display::COLUMNS + 1];
+    display.clear();
+    display.print("GenSeq ");
+    display.printGlyph(state.playing ? LCD_GLYPH_PLAY : LCD_GLYPH_STOP);
+    display.setCursor(1, 0);
+    snprintf(text, sizeof(text), "Value %2u", (unsigned)value);
+    display.print(text);
+    display.drawBar(1, VALUE_BAR_POSITION, VALUE_BAR_WIDTH, value, VALUE_MAX);
+
+}
+
+void InitView::onTelemetry(const commands::Telemetry& telemetry)
+{
+    // Playhead of the first pattern, scaled to the 16 columns
+    uint8_t playhead = hardware::LedMatrix::WIDTH;
+    const commands::PatternTelemetry& first = telemetry.patterns[0];
+    if (telemetry.playing && first.length > 0) {
+        playhead = (uint32_t)first.tick * hardware::LedMatrix::WIDTH / first.length;
+    }
+
+    for (uint8_t x = 0; x < hardware::LedMatrix::WIDTH; x++) {
+        uint32_t color = 0;
+        if (x == playhead) {
+            color = PLAYHEAD_COLOR;
+        }
+        else if (x < MAX_PATTERNS && telemetry.patterns[x].note != commands::Telemetry::NO_NOTE) {
+            color = NOTE_COLOR;
+        }
+        else if (x < MAX_PATTERNS && (telemetry.activePatterns >> x) & 1u) {
+            color = PATTERN_COLOR;
+        }
+        ledMatrix.setPixel(x, ACTIVITY_ROW, color);
 
+        if (x < MAX_PATTERNS && (telemetry.noteOns >> x) & 1u) {
+            const hardware::Keyframe flash[] = {
+                { 0, static_cast<int8_t>(x), ACTIVITY_ROW, FLASH_COLOR },
+                { FLASH_STEPS, static_cast<int8_t>(x), ACTIVITY_ROW, NOTE_COLOR },
+            };
+            // The previous flash of this column would clear the new one's pixel when it ends.
+            // With every slot busy the note simply does not flash.
+            compositor.stopAnimation(flashIds[x]);
+            flashIds[x] = compositor.animate(FLASH_LAYER, 1, 1, flash, 2, false);
+        }
+    }
 }
 
 } // namespace ui
@@ -3,19 +3,45 @@
 #include "IView.h"
 #include "../hardware/Led.h"
 #include "../hardware/LedMatrix.h"
+#include "../hardware/LedCompositor.h"
+#include "../hardware/Display.h"
 
 namespace ui {
 
 class InitView : public IView {
 public:
-    InitView(hardware::Led& led, hardware::LedMatrix& ledMatrix);
+    InitView(hardware::Led& led, hardware::LedMatrix& ledMatrix, hardware::LedCompositor& compositor,
+        hardware::Display& display);
 
     void onEnter() override;
+    void onExit() override;
     void render(const state::UIState& state) override;
+    void onTelemetry(const commands::Telemetry& telemetry) override;
 
 private:
     hardware::Led& led;
     hardware::LedMatrix& ledMatrix;
+    hardware::LedCompositor& compositor;
+    hardware::Display& display;
+
+    // Row between the label and the number, one column per pattern slot. Colors are perceptual,
+    // LedMatrix applies gamma 2.2 when it commits them.
+    static constexpr uint8_t ACTIVITY_ROW = 5;
+    static constexpr uint32_t PLAYHEAD_COLOR = 0x00FF004A;
+    static constexpr uint32_t NOTE_COLOR = 0xFF000066;
+    static constexpr uint32_t PATTERN_COLOR = 0x10484800;
+    // New notes flash bright and fade into NOTE_COLOR
+    static constexpr uint8_t FLASH_LAYER = 0;
+    static constexpr uint32_t FLASH_COLOR = 0x00FFFFFF;
+    static constexpr uint16_t FLASH_STEPS = 9;
+
+    // LCD: transport icon on the first line, the value and a bar graph of it on the second
+    static constexpr uint8_t VALUE_MAX = 99;
+    static constexpr uint8_t VALUE_BAR_POSITION = 9;
+    static constexpr uint8_t VALUE_BAR_WIDTH = hardware::Display::COLUMNS - VALUE_BAR_POSITION;
+
+    // Running flash per activity column, a retrigger restarts it
+    uint8_t flashIds[MAX_PATTERNS];
 };
 
 } // namespace ui
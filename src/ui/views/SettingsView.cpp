@@ -15,7 +15,7 @@ void SettingsView::onEnter()
 void SettingsView::render(const state::UIState& state)
 {
     // TODO: Implement settings view rendering
-    ledMatrix.drawLabel("SET", 0xFF00FF33);
+    ledMatrix.drawLabel("SET", 0xFF00FF7B);
 }
 
 } // namespace ui